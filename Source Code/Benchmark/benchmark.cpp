@@ -0,0 +1,427 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+// Benchmark of the solver kernels: every scheme, grid sizes from 10^2 to 10^7 nodes and several thread counts.
+// Each measurement is printed as one JSON object (one per line), so that the results can be compared between builds and machines.
+// The solvers also report their largest error against exact_solution, showing what the float and mixed precision kernels lose:
+//   heat1d_benchmark [--min-nodes N] [--max-nodes N] [--budget node-steps] [--threads 1,2,4] [--kernels dufort,richardson,...] [--hardware 1] [--memory-limit bytes]
+// Every measurement reports the allocations and the peak memory of the solver data; a measurement that would exceed --memory-limit is skipped.
+// With --hardware 1, the first object is the roofline of the machine and every measurement also gets the CPU counters of the solver
+// (Linux perf_event_open, null where the machine does not give them) and its place on the roofline.
+// dufort_start1 to dufort_start4 time the first time step of DuFort-Frankel alone with each start method, on a time step 20 times over the
+// FTCS stability limit, and give its error: the cheapest accurate start for each grid (method 3 Laasonen, method 4 FTCS sub-steps).
+// The suffix _symmetric solves only the half of the wall up to its centreline (setSymmetric) and mirrors the other half.
+// laasonen_batch and crankNicolson_batch advance BatchWalls walls together (BatchTridiagonal), the node-steps counting every wall.
+
+
+#include "analysis.h"
+#include "profiler.h"
+#include "memorytracker.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+
+// Configuration of the benchmark, set from the command line
+struct BenchmarkOptions {
+	long long minNodes, maxNodes;
+	double budget; // node-steps per measurement: the number of time steps is budget / nodes
+	vector<int> threads; // thread counts to measure
+	vector<string> kernels; // kernels to measure
+	bool hardware; // CPU counters and roofline of each measurement
+	long long memoryLimit; // bytes of solver data, 0: none
+};
+
+// Memory traffic model of one node-step of a kernel (bytes), used to turn times into bandwidth:
+// each array streamed in or out of the cache counts for 8 bytes per node.
+struct Kernel {
+	string name;
+	double bytesPerNodeStep;
+	bool timeStepping; // false for exact_solution: one evaluation per run, whatever the number of steps
+	bool sharedGrid; // the threads work together on one grid (instead of one copy of the problem per thread)
+	int precision; // setPrecision of the solver: 1 double, 2 float (suffix _float), 3 float storage and double arithmetic (suffix _mixed)
+	int walls; // walls solved by one run (BatchWalls for the batch solvers, otherwise 1)
+};
+
+static const int BatchWalls = 8; // walls of different diffusivities advanced together by laasonen_batch and crankNicolson_batch
+
+
+static double seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static bool endsWith(const string& name, const string& suffix) {
+	return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static vector<string> split(const string& list) {
+	vector<string> items;
+	stringstream stream(list);
+	string item;
+	while (getline(stream, item, ',')) {
+		if (!item.empty())
+			items.push_back(item);
+	}
+	return items;
+}
+
+static BenchmarkOptions parseOptions(int argc, char** argv) {
+	BenchmarkOptions options;
+	options.minNodes = 100;
+	options.maxNodes = 10000000;
+	options.budget = 3e7;
+	options.hardware = false;
+	options.memoryLimit = 0;
+	options.threads.push_back(1);
+	int hardware = int(thread::hardware_concurrency());
+	for (int t = 2; t <= hardware; t *= 2) {
+		options.threads.push_back(t);
+	}
+	options.kernels = split("dufort,richardson,dufort_parallel,richardson_parallel,laasonen,crankNicolson,thomas_algorithm,laasonen_partitioned,crankNicolson_partitioned,exact_solution,"
+		"dufort_float,dufort_mixed,laasonen_float,laasonen_mixed,crankNicolson_float,crankNicolson_mixed,dufort_start3,dufort_start4,laasonen_batch,crankNicolson_batch,"
+		"dufort_symmetric,laasonen_symmetric,crankNicolson_symmetric,exact_solution_symmetric");
+
+	for (int k = 1; k + 1 < argc; k += 2) {
+		string key = argv[k];
+		string value = argv[k + 1];
+		if (key == "--min-nodes")
+			options.minNodes = atoll(value.c_str());
+		else if (key == "--max-nodes")
+			options.maxNodes = atoll(value.c_str());
+		else if (key == "--budget")
+			options.budget = atof(value.c_str());
+		else if (key == "--threads") {
+			options.threads.clear();
+			vector<string> items = split(value);
+			for (int i = 0; i < int(items.size()); i++) {
+				options.threads.push_back(atoi(items[i].c_str()));
+			}
+		}
+		else if (key == "--kernels")
+			options.kernels = split(value);
+		else if (key == "--hardware")
+			options.hardware = (atoi(value.c_str()) != 0);
+		else if (key == "--memory-limit")
+			options.memoryLimit = (long long)atof(value.c_str());
+	}
+	return options;
+}
+
+static Kernel findKernel(const string& name) {
+	Kernel k;
+	k.name = name;
+	k.timeStepping = true;
+	k.sharedGrid = false;
+	k.precision = 1;
+	k.walls = 1;
+	if (endsWith(name, "_float") || endsWith(name, "_mixed")) { // same traffic as the double kernel, on 4 byte values
+		k = findKernel(name.substr(0, name.size() - 6));
+		k.name = name;
+		k.precision = endsWith(name, "_float") ? 2 : 3;
+		k.bytesPerNodeStep /= 2;
+	}
+	else if (endsWith(name, "_symmetric")) { // half of the wall solved, the other half mirrored
+		k = findKernel(name.substr(0, name.size() - 10));
+		k.name = name;
+		k.bytesPerNodeStep /= 2;
+	}
+	else if (name == "dufort" || name == "richardson")
+		k.bytesPerNodeStep = 24; // read n - 1 and n, write n + 1
+	else if (name.compare(0, 12, "dufort_start") == 0) { // one first step per run
+		k.timeStepping = false;
+		if (name == "dufort_start3")
+			k.bytesPerNodeStep = 120; // diagonals built and factorised, then one solve
+		else if (name == "dufort_start4")
+			k.bytesPerNodeStep = 40 * 16; // 40 sub-steps at half the stability limit, each reading and writing one level
+		else
+			k.bytesPerNodeStep = 16;
+	}
+	else if (name == "dufort_parallel" || name == "richardson_parallel") {
+		k.bytesPerNodeStep = 24;
+		k.sharedGrid = true;
+	}
+	else if (name == "laasonen_batch") {
+		k.bytesPerNodeStep = 56; // as laasonen, for each wall of the batch
+		k.walls = BatchWalls;
+	}
+	else if (name == "crankNicolson_batch") {
+		k.bytesPerNodeStep = 88; // right hand side assembled in its own pass (init in, d out), solve, then copied back to init
+		k.walls = BatchWalls;
+	}
+	else if (name == "laasonen")
+		k.bytesPerNodeStep = 56; // forward: d, a, pivot in, d out / backward: d, c' in, d out
+	else if (name == "crankNicolson")
+		k.bytesPerNodeStep = 56; // one fused pass: assembly and forward substitution, then back substitution, in place
+	else if (name == "thomas_algorithm")
+		k.bytesPerNodeStep = 104; // factorisation of a, b, c at each call, then solve
+	else if (name == "laasonen_partitioned") {
+		k.bytesPerNodeStep = 88; // local solves as laasonen, then correction: d, v, w in, d out
+		k.sharedGrid = true;
+	}
+	else if (name == "crankNicolson_partitioned") {
+		k.bytesPerNodeStep = 120;
+		k.sharedGrid = true;
+	}
+	else {
+		k.bytesPerNodeStep = 8; // one node written per evaluation (the cost is the arithmetic)
+		k.timeStepping = false;
+		k.sharedGrid = true;
+	}
+	return k;
+}
+
+static const double L = 31, D = 93; // wall of the benchmark problem
+
+static double timeStep(const string& name, int nodes) {
+	double dx = L / (nodes - 1);
+	if (name.compare(0, 12, "dufort_start") == 0)
+		return 10 * dx * dx / D; // a = 2 D dt / dx^2 = 20: a single FTCS step is unstable
+	return 0.05 * dx * dx / D; // small enough for the values to stay finite over the run
+}
+
+// run the kernel once on a grid of "nodes" nodes over "steps" time steps, returns the temperature at the end of the run
+// (empty for thomas_algorithm and exact_solution, which do not solve the heat equation over the steps)
+static Vector runKernel(const string& name, int precision, int nodes, int steps, int threads) {
+	double dx = L / (nodes - 1);
+	double dt = timeStep(name, nodes);
+	bool symmetric = (name.find("_symmetric") != string::npos);
+	Vector solution;
+	if (name.compare(0, 6, "dufort") == 0 || name.compare(0, 10, "richardson") == 0) {
+		Explicit solver;
+		if (name.find("_parallel") != string::npos) // one grid split between the threads
+			solver.setThreads(threads);
+		solver.setDeltat(dt);
+		solver.setDeltax(dx);
+		solver.setD_value(D);
+		solver.setSpaceDomain(nodes - 1);
+		solver.setTimeDomain(steps + 1);
+		solver.setT_surf(149);
+		solver.setT_init(38);
+		solver.setPrecision(precision);
+		solver.setSymmetric(symmetric);
+		if (name.compare(0, 12, "dufort_start") == 0) // the start method alone: levels 0 and 1
+			solution = solver.duFortSolve(atoi(name.c_str() + 12));
+		else if (name.compare(0, 6, "dufort") == 0)
+			solution = solver.duFortSolve(1);
+		else
+			solution = solver.richardsonSolve();
+	}
+	else if (name.compare(0, 8, "laasonen") == 0 || name.compare(0, 13, "crankNicolson") == 0 || name == "thomas_algorithm") {
+		Implicit solver;
+		if (name.find("_partitioned") != string::npos) { // one grid solved by all the threads, whatever its size
+			solver.setThreads(threads);
+			solver.setParallelThreshold(0);
+		}
+		solver.setDeltat(dt);
+		solver.setDeltax(dx);
+		solver.setD_value(D);
+		solver.setSpaceDomain(nodes - 1);
+		solver.setTimeDomain(steps + 1);
+		solver.setT_surf(149);
+		solver.setT_init(38);
+		solver.setPrecision(precision);
+		solver.setSymmetric(symmetric);
+		if (name.find("_batch") != string::npos) { // the wall of the other kernels first, then walls of higher diffusivities
+			Vector Diffs(BatchWalls), Tsurfs(BatchWalls), Tinits(BatchWalls);
+			for (int k = 0; k < BatchWalls; k++) {
+				Diffs[k] = D * (1 + 0.125 * k);
+				Tsurfs[k] = 149;
+				Tinits[k] = 38;
+			}
+			std::vector<Vector> walls = (name.compare(0, 8, "laasonen") == 0) ? solver.laasonenSolveBatch(Diffs, Tsurfs, Tinits)
+				: solver.crankNicolsonSolveBatch(Diffs, Tsurfs, Tinits);
+			solution = walls[0];
+		}
+		else if (name.compare(0, 8, "laasonen") == 0)
+			solution = solver.laasonenSolve();
+		else if (name.compare(0, 13, "crankNicolson") == 0)
+			solution = solver.crankNicolsonSolve();
+		else {
+			double r = D * dt / (dx * dx);
+			Vector a(nodes), b(nodes), c(nodes), d(nodes);
+			for (int i = 0; i < nodes; i++) {
+				a[i] = (i == 0) ? 0 : -r;
+				b[i] = 1 + 2 * r;
+				c[i] = (i == nodes - 1) ? 0 : -r;
+				d[i] = 38;
+			}
+			solver.setDiagonals(a, b, c);
+			PROFILE_KERNEL("thomas_algorithm", 9, 13 * sizeof(double)); // factorisation: a, b, c in, c', pivot out, then the solve
+			for (int t = 0; t < steps; t++) {
+				d = solver.thomas_algorithm(d);
+			}
+		}
+	}
+	else {
+		ExactSolution exact(D, L, 149, 38);
+		exact.setThreads(threads);
+		exact.setSymmetric(symmetric);
+		exact.setTime(0.001);
+		exact.evaluate(nodes, dx);
+	}
+	return solution;
+}
+
+// largest difference between the solution of a run and exact_solution at the end of the run, -1 if there is no solution
+// or if the series of exact_solution is cut before converging (too close to t = 0 for the modes allowed)
+static double maxError(const string& name, const Vector& solution, int nodes, int steps) {
+	if (solution.getSize() != nodes)
+		return -1;
+	ExactSolution exact(D, L, 149, 38);
+	exact.setTime(steps * timeStep(name, nodes));
+	if (exact.getModeCount() >= 1000)
+		return -1;
+	Vector reference = exact.evaluate(nodes, L / (nodes - 1));
+	double error = 0;
+	for (int i = 0; i < nodes; i++) {
+		error = max(error, fabs(solution[i] - reference[i]));
+	}
+	return error;
+}
+
+// time the kernel: the solvers are sequential, so with several threads each one runs its own copy of the problem
+// (throughput of a node full of independent runs); exact_solution, the parallel and the partitioned solvers share one grid between the threads.
+// The solution of the run (of the first copy) is written in solution
+static double measure(const Kernel& kernel, int nodes, int steps, int threads, Vector& solution) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	if (kernel.sharedGrid || threads == 1)
+		solution = runKernel(kernel.name, kernel.precision, nodes, steps, threads);
+	else {
+		vector<thread> workers;
+		vector<exception_ptr> failures(threads); // MemoryLimitExceeded of a copy, rethrown to main once every copy is joined
+		for (int k = 0; k < threads; k++) {
+			workers.push_back(thread([&kernel, &failures, nodes, steps, k] {
+				try {
+					runKernel(kernel.name, kernel.precision, nodes, steps, 1);
+				}
+				catch (...) {
+					failures[k] = current_exception();
+				}
+			}));
+		}
+		for (int k = 0; k < threads; k++) {
+			workers[k].join();
+		}
+		for (int k = 0; k < threads; k++) {
+			if (failures[k])
+				rethrow_exception(failures[k]);
+		}
+	}
+	return seconds(start);
+}
+
+
+// name under which the profiler measures the solver of a kernel (the precision and parallel variants share the solver)
+static string profiledKernel(const string& name) {
+	if (name == "thomas_algorithm" || name.compare(0, 14, "exact_solution") == 0)
+		return name;
+	return name.substr(0, name.find('_'));
+}
+
+// CPU counters per node-step and roofline of the solver measured since the last reset of the profiler
+static void printHardware(const string& name, double nodeSteps) {
+	KernelStatistics k = Profiler::instance().getKernel(profiledKernel(name));
+	const Roofline& roofline = Profiler::instance().getRoofline();
+	const char* fields[EventCount] = { "cycles_per_node_step", "instructions_per_node_step", "cache_misses_per_node_step", "branch_misses_per_node_step" };
+	for (int e = 0; e < EventCount; e++) {
+		cout << ", \"" << fields[e] << "\": ";
+		if (k.runs > 0 && k.events[e] >= 0)
+			cout << k.events[e] / nodeSteps;
+		else
+			cout << "null";
+	}
+	double bytes = (k.events[EventCacheMisses] > 0) ? 64.0 * k.events[EventCacheMisses] : k.modelBytes; // measured traffic, else the model
+	if (k.runs == 0 || k.seconds <= 0 || bytes <= 0) {
+		cout << ", \"arithmetic_intensity\": null, \"achieved_gflops\": null, \"attainable_gflops\": null, \"bound\": null";
+		return;
+	}
+	RooflinePoint point = placeOnRoofline(roofline, k.flops, bytes, k.seconds);
+	cout << ", \"arithmetic_intensity\": " << point.intensity << ", \"achieved_gflops\": " << point.achievedGflops
+		<< ", \"attainable_gflops\": " << point.attainableGflops << ", \"bound\": \"" << point.bound << "\"";
+}
+
+
+int main(int argc, char** argv) {
+	BenchmarkOptions options = parseOptions(argc, argv);
+	MemoryTracker& memory = MemoryTracker::instance();
+	memory.setLimit(options.memoryLimit);
+	cout << "[" << endl;
+	bool first = true;
+	if (options.hardware) {
+		Profiler::instance().setHardwareCounters(true); // measures the roofline of the machine
+		const Roofline& roofline = Profiler::instance().getRoofline();
+		cout << "  {\"roofline\": {\"bandwidth_gb_per_s\": " << roofline.bandwidth << ", \"peak_gflops\": " << roofline.peakGflops
+			<< ", \"ridge_flops_per_byte\": " << roofline.peakGflops / roofline.bandwidth << "}}" << endl;
+		first = false;
+	}
+	for (int k = 0; k < int(options.kernels.size()); k++) {
+		Kernel kernel = findKernel(options.kernels[k]);
+		for (long long nodes = options.minNodes; nodes <= options.maxNodes; nodes *= 10) {
+			int steps = kernel.timeStepping ? int(max(3.0, options.budget / (nodes * kernel.walls))) : 1;
+			double reference = 0; // time of the single thread run
+			double error = -1; // against exact_solution, measured on the single thread run
+			for (int t = 0; t < int(options.threads.size()); t++) {
+				int threads = options.threads[t];
+				Vector solution;
+				double time;
+				long long before;
+				try {
+					measure(kernel, int(nodes), (steps > 10) ? steps / 10 : 1, threads, solution); // warm up: page faults, caches, frequency
+					Profiler::instance().reset(); // the counters of the measurement only
+					before = memory.getLiveBytes();
+					time = measure(kernel, int(nodes), steps, threads, solution);
+				}
+				catch (const MemoryLimitExceeded& limit) {
+					cerr << kernel.name << ", " << nodes << " nodes, " << threads << " threads: " << limit.what() << endl;
+					continue;
+				}
+				double copies = (kernel.sharedGrid) ? 1 : threads; // independent problems solved during the measurement
+				double nodeSteps = double(nodes) * steps * copies * kernel.walls;
+				if (threads == 1) {
+					reference = time;
+					error = maxError(kernel.name, solution, int(nodes), steps);
+				}
+
+				cout << (first ? "  " : ", ") << "{\"kernel\": \"" << kernel.name << "\", \"nodes\": " << nodes << ", \"steps\": " << steps
+					<< ", \"threads\": " << threads << ", \"seconds\": " << time
+					<< ", \"ns_per_node_step\": " << time * 1e9 / nodeSteps
+					<< ", \"gb_per_s\": " << kernel.bytesPerNodeStep * nodeSteps / time / 1e9
+					<< ", \"speedup\": " << ((reference > 0) ? reference * copies / time : 0) << ", \"max_error\": ";
+				if (error >= 0)
+					cout << error;
+				else
+					cout << "null";
+				cout << ", \"allocations\": " << memory.getAllocations() << ", \"peak_bytes\": " << memory.getPeakBytes() - before;
+				if (options.hardware)
+					printHardware(kernel.name, nodeSteps);
+				cout << "}" << endl;
+				first = false;
+			}
+		}
+	}
+	cout << "]" << endl;
+	return 0;
+}
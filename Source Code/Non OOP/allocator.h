@@ -0,0 +1,72 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <cstddef> // std::size_t
+#include <new>     // aligned operator new/delete
+
+
+/**
+*  Standard-conforming allocator returning memory aligned on "Alignment" bytes.
+*  \n The storage of the Vector objects is aligned on a cache line (64 bytes), so that the
+*  \n solver loops can use aligned SIMD loads and stores, and a node row never straddles two cache lines more than needed.
+*/
+template <class T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+	typedef T value_type;
+
+	/** rebind: the same allocator for another type, as required by the standard containers */
+	template <class U>
+	struct rebind {
+		typedef AlignedAllocator<U, Alignment> other;
+	};
+
+	AlignedAllocator() noexcept {}
+
+	template <class U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+	/**
+	* allocate room for n objects of type T, aligned on Alignment bytes
+	* @exception std::bad_alloc if the memory cannot be allocated
+	*/
+	T* allocate(std::size_t n) {
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+	}
+
+	/** release memory obtained from allocate */
+	void deallocate(T* p, std::size_t) noexcept {
+		::operator delete(p, std::align_val_t(Alignment));
+	}
+};
+
+/** all the AlignedAllocator objects are interchangeable (stateless) */
+template <class T, class U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept {
+	return true;
+}
+
+template <class T, class U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept {
+	return false;
+}
+
+#endif
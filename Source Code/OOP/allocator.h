@@ -0,0 +1,91 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <cstddef> // std::size_t
+#include <new>     // aligned operator new/delete
+#include <vector>
+
+// accounting of the memory of the solver data, see MemoryTracker (memorytracker.h)
+// @exception MemoryLimitExceeded (a std::bad_alloc) if the allocation would exceed the memory limit
+void trackAllocation(std::size_t bytes);
+void trackDeallocation(std::size_t bytes) noexcept;
+
+
+/**
+*  Standard-conforming allocator returning memory aligned on "Alignment" bytes.
+*  \n The storage of the Vector objects is aligned on a cache line (64 bytes), so that the
+*  \n solver loops can use aligned SIMD loads and stores, and a node row never straddles two cache lines more than needed.
+*  \n Every allocation is accounted by the MemoryTracker, which can refuse it when a memory limit is set.
+*/
+template <class T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+	typedef T value_type;
+
+	/** rebind: the same allocator for another type, as required by the standard containers */
+	template <class U>
+	struct rebind {
+		typedef AlignedAllocator<U, Alignment> other;
+	};
+
+	AlignedAllocator() noexcept {}
+
+	template <class U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+	/**
+	* allocate room for n objects of type T, aligned on Alignment bytes
+	* @exception std::bad_alloc if the memory cannot be allocated or the memory limit would be exceeded
+	*/
+	T* allocate(std::size_t n) {
+		trackAllocation(n * sizeof(T));
+		try {
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+		}
+		catch (...) {
+			trackDeallocation(n * sizeof(T));
+			throw;
+		}
+	}
+
+	/** release memory obtained from allocate */
+	void deallocate(T* p, std::size_t n) noexcept {
+		trackDeallocation(n * sizeof(T));
+		::operator delete(p, std::align_val_t(Alignment));
+	}
+};
+
+/** all the AlignedAllocator objects are interchangeable (stateless) */
+template <class T, class U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept {
+	return true;
+}
+
+template <class T, class U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) noexcept {
+	return false;
+}
+
+/** array of any type on aligned storage (Vector is the double one), e.g. the float levels of the single precision solvers */
+template <class T>
+using AlignedVector = std::vector<T, AlignedAllocator<T, 64> >;
+
+#endif
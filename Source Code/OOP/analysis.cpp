@@ -1,294 +1,463 @@
-/***********************************************************************\
-#                                                                       #
-#                C R A N F I E L D   U N I V E R S I T Y                #
-#                          2 0 1 9  /  2 0 2 0                          #
-#                                                                       #
-#               MSc in Aerospace Computational Engineering              #
-#                                                                       #
-#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
-#                                                                       #
-#-----------------------------------------------------------------------#
-#                                                                       #
-#   Main Contributors:                                                  #
-#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
-#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
-#                                                                       #
-\***********************************************************************/
-
-
-#include "analysis.h"
-#include <fstream> // To write into a .CSV file
-#include <cmath>
-#include <iomanip>
-using namespace std;
-
-
-// Default contructor
-Analysis::Analysis(double Diff, double dx, double dt, double L, double output_Time, double T_surf, double T_init, int choice_duFort) { // this->x == (*this).x
-	(*this).D_value               = Diff;          // or this->D_value               = Diff
-	(*this).deltax                = dx;            // or this->deltax                = dx
-	(*this).deltat                = dt;            // or this->deltat                = dt
-	(*this).thickness             = L;             // or this->thickness             = L
-	(*this).outputTime            = output_Time;   // or this->outputTime            = output_Time
-	(*this).t_surf                = T_surf;        // or this->t_surf                = T_surf
-	(*this).t_init                = T_init;        // or this->t_init                = T_init
-	(*this).DufortFirstStepMethod = choice_duFort; // or this->DufortFirstStepMethod = choice_duFort
-}
-
-// Get & Set methods
-void Analysis::setD_value(double D) {
-	D_value = D;
-}
-
-void Analysis::setDeltax(double x) {
-	deltax = x;
-}
-
-void Analysis::setDeltat(double t) {
-	deltat = t;
-}
-
-void Analysis::setThickness(double L) {
-	thickness = L;
-}
-
-void Analysis::setOutputTime(double outTime) {
-	outputTime = outTime;
-}
-
-void Analysis::setT_surf(double Tsurf) {
-	t_surf = Tsurf;
-}
-
-void Analysis::setT_init(double Tinit) {
-	t_init = Tinit;
-}
-
-void  Analysis::setDufortFirstStepMethod(int choice) {
-	DufortFirstStepMethod = choice;
-}
-
-// Methods
-/* similar to:
-type Analysis::initialiseImplicit(type impl) {
-	...;
-	return type;
-}*/
-Implicit Analysis::initialiseImplicit(Implicit impl) {
-	impl.setDeltat(deltat);
-	impl.setDeltax(deltax);
-	impl.setD_value(D_value);
-	impl.setSpaceDomain(int(thickness / deltax)); // space domain set as the integer value of the thickness of the wall divided by the space step.
-	impl.setTimeDomain(int(outputTime / deltat)); // space domain set as the integer value of the thickness of the wall divided by the time step.
-	impl.setT_surf(t_surf);
-	impl.setT_init(t_init);
-	return impl;
-}
-
-Explicit Analysis::initialiseExplicit(Explicit expl) {
-	expl.setDeltat(deltat);
-	expl.setDeltax(deltax);
-	expl.setD_value(D_value);
-	expl.setSpaceDomain(int(thickness / deltax)); // space domain set as the integer value of the thickness of the wall divided by the space step.
-	expl.setTimeDomain(int(outputTime / deltat)); // space domain set as the integer value of the thickness of the wall divided by the time step.
-	expl.setT_surf(t_surf);
-	expl.setT_init(t_init);
-	return expl;
-}
-
-void Analysis::printExplicit_duFordFrankel() {
-	//creation and initialisation of an Explicit object
-	Explicit solver;
-	solver = initialiseExplicit(solver);
-	/* solver = initialiseExplicit(solver); ---> this replace all the following arguments:
-	Explicit solver;
-	solver.setDeltat(deltat);
-	solver.setDeltax(deltax);
-	solver.setD_value(D_value);
-	solver.setSpaceDomain(int(thickness / deltax));
-	solver.setTimeDomain(int(outputTime / deltat));
-	solver.setT_surf(t_surf);
-	solver.setT_init(t_init);*/
-	Vector v1 = solver.duFortSolve(DufortFirstStepMethod);
-	ofstream outfile("duFortFrankel.csv");
-	if (outfile.is_open()) {
-		outfile << "x (m)" << "," << "T (K)" << endl;
-		for (int i = 0; i < v1.size(); i++) {
-			outfile << fixed << setprecision(4) << (i * deltax) << "," << v1[i] << endl;
-		}
-		outfile.close();
-	}
-}
-
-void Analysis::printExplicit_richardson() {
-	Explicit solver;
-	solver = initialiseExplicit(solver);
-	Vector v1 = solver.richardsonSolve();
-	ofstream outfile("Richardson.csv");
-	if (outfile.is_open()) {
-		outfile << "x (m)" << "," << "T (K)" << endl;
-		for (int i = 0; i < v1.size(); i++) {
-			outfile << fixed << setprecision(4) << (i * deltax) << "," << v1[i] << endl;
-		}
-		outfile.close();
-	}
-}
-
-void Analysis::printImplicit_laasonen() {
-	Implicit solver;
-	solver = initialiseImplicit(solver);
-	Vector v1 = solver.laasonenSolve();
-	ofstream outfile("laasonen.csv");
-	if (outfile.is_open()) {
-		outfile << "x (m)" << "," << "T (K)" << endl;
-		for (int i = 0; i < v1.size(); i++) {
-			outfile << fixed << setprecision(4) << (i * deltax) << "," << v1[i] << endl;
-		}
-		outfile.close();
-	}
-}
-
-void Analysis::printImplicit_crankNicolson() {
-	Implicit solver;
-	solver = initialiseImplicit(solver);
-	Vector v1 = solver.crankNicolsonSolve();
-	ofstream outfile("crankNicolson.csv");
-	if (outfile.is_open()) {
-		outfile << "x (m)" << "," << "T (K)" << endl;
-		for (int i = 0; i < v1.size(); i++) {
-			outfile << fixed << setprecision(4) << (i * deltax) << "," << v1[i] << endl;
-		}
-		outfile.close();
-	}
-}
-
-Vector Analysis::exact_solution() {
-	double pi = 3.1415926535;
-	Vector v1;
-	int acc = 100;
-	int spaceDomain = int(thickness / deltax);
-	for (int i = 0; i < spaceDomain + 1; i++) {
-		double sum = 0.0;
-		for (int j = 1; j < acc; j++) {
-			sum += exp(-D_value * pow((j * pi / (thickness)), 2) * outputTime) * ((1 - pow(-1, j)) / (j * pi)) * sin(j * pi * (i * deltax) / (thickness)); // Analytical (Exact) Solution 
-		}
-		v1.push_back(t_surf + (2 * (t_init - t_surf) * sum));
-	}
-	return v1;
-}
-
-void Analysis::print_exact_solution() {
-	Vector v1 = exact_solution();
-	///write the exact solution and return it as well.
-	ofstream outfile("exact_solution.csv");
-	if (outfile.is_open()) {
-		outfile << "x (m)" << "," << "T (K)" << endl;
-		for (int i = 0; i < v1.size(); i++) {
-			outfile << fixed << setprecision(4) << (i * deltax) << "," << v1[i] << endl;
-		}
-		outfile.close();
-	}
-}
-
-Vector Analysis::printErrors(int numerical_scheme) {
-	Vector v1 = exact_solution();
-	Vector v2;
-	Vector errors(v1.size());
-	string file;
-
-	Explicit expl;
-	expl = initialiseExplicit(expl);
-	Implicit impl;
-	impl = initialiseImplicit(impl);
-	
-	// for the numerical numerical_scheme chosen, write the errors in a .csv file, and return them as well
-	switch (numerical_scheme) {
-		case 1: {
-			v2 = expl.duFortSolve(DufortFirstStepMethod);
-			file = "errors_duFort.csv";
-			break;
-		}
-		case 2: {
-			v2 = expl.richardsonSolve();
-			file = "errors_richardson.csv";
-			break;
-		}
-		case 3: {
-			v2 = impl.laasonenSolve();
-			file = "errors_laasonen.csv";
-			break;
-		}
-		case 4: {
-			v2 = impl.crankNicolsonSolve();
-			file = "errors_crankNicolson.csv";
-			break;
-		}
-	}
-
-	ofstream outfile(file);
-	if (outfile.is_open()) {
-		outfile << "x (m)" << "," << "Error" << endl;
-		for (int i = 0; i < v1.size(); i++) {
-			errors[i] = abs(v1[i] - v2[i]);
-			outfile << (i * deltax) << "," << errors[i] << endl;
-		}
-		outfile.close(); 
-	}
-	return errors;
-}
-
-void Analysis::printTimeFunction(double positionToSee, double timeToSee, int numerical_scheme) {
-	// for the numerical_scheme chosen (int numerical_scheme), evolution of the temperature at the node int(positionToSee/delta x) in time until t=timeToSee
-	string file;
-	int space = int(positionToSee / deltax);
-	int time = int(timeToSee / deltat);
-	Vector v1 = {};
-	Explicit expl;
-	expl = initialiseExplicit(expl);
-	Implicit impl;
-	impl = initialiseImplicit(impl);
-
-	// check wether the node we are looking at is inside the domain
-	if (positionToSee <= thickness) {
-		for (int t = 0; t <= time; t++) {
-			switch (numerical_scheme) {
-				case 1: {
-					file = "timeFunction_duFort.csv";
-					expl.setTimeDomain(t);
-					v1.push_back(expl.duFortSolve(DufortFirstStepMethod)[space]);
-					break;
-				}
-				case 2: {
-					file = "timeFunction_richardson.csv";
-					expl.setTimeDomain(t);
-					v1.push_back(expl.richardsonSolve()[space]);
-					break;
-				}
-				case 3: {
-					file = "timeFunction_laasonen.csv";
-					impl.setTimeDomain(t);
-					v1.push_back(impl.laasonenSolve()[space]);
-					break;
-				}
-				case 4: {
-					file = "timeFunction_crankNicolson.csv";
-					impl.setTimeDomain(t);
-					v1.push_back(impl.crankNicolsonSolve()[space]);
-					break;
-				}
-			}
-		}
-
-		ofstream outfile(file);
-		if (outfile.is_open()) {
-			outfile << "At x = " << positionToSee << endl;
-			outfile << "t (s)" << "," << "T (K)" << endl;
-			for (int i = 0; i < v1.size(); i++) {
-				outfile << (i * deltat) << fixed << setprecision(4) << "," << v1[i] << endl;
-			}
-			outfile.close(); 
-		}
-	}
-	else
-		cout << "The value of x chosen is out of borders!" << endl;
-}
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "analysis.h"
+#include "profiler.h" // phase timers and counters
+#include <fstream> // To write into a .CSV file
+#include <cmath>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+
+// Default contructor
+Analysis::Analysis(double Diff, double dx, double dt, double L, double output_Time, double T_surf, double T_init, int choice_duFort) { // this->x == (*this).x
+	(*this).D_value               = Diff;          // or this->D_value               = Diff
+	(*this).deltax                = dx;            // or this->deltax                = dx
+	(*this).deltat                = dt;            // or this->deltat                = dt
+	(*this).thickness             = L;             // or this->thickness             = L
+	(*this).outputTime            = output_Time;   // or this->outputTime            = output_Time
+	(*this).t_surf                = T_surf;        // or this->t_surf                = T_surf
+	(*this).t_init                = T_init;        // or this->t_init                = T_init
+	(*this).DufortFirstStepMethod = choice_duFort; // or this->DufortFirstStepMethod = choice_duFort
+	(*this).outputFormat          = 1;             // .csv files unless setOutputFormat is called
+	(*this).threads               = 1;             // serial solvers unless setThreads is called
+	(*this).adaptiveTolerance     = 0;             // uniform time steps unless setAdaptiveTolerance is called
+	(*this).steadyTolerance       = 0;             // no early stop unless setSteadyTolerance is called
+	(*this).precision             = 1;             // double precision unless setPrecision is called
+	(*this).starterFraction       = 0.5;           // sub-steps of half the FTCS stability limit unless setStarterSubstep is called
+	(*this).symmetric             = false;         // the whole wall is computed unless setSymmetric is called
+	(*this).stoppedStep           = -1;
+}
+
+// Get & Set methods
+void Analysis::setD_value(double D) {
+	D_value = D;
+}
+
+void Analysis::setDeltax(double x) {
+	deltax = x;
+}
+
+void Analysis::setDeltat(double t) {
+	deltat = t;
+}
+
+void Analysis::setThickness(double L) {
+	thickness = L;
+}
+
+void Analysis::setOutputTime(double outTime) {
+	outputTime = outTime;
+}
+
+void Analysis::setT_surf(double Tsurf) {
+	t_surf = Tsurf;
+}
+
+void Analysis::setT_init(double Tinit) {
+	t_init = Tinit;
+}
+
+void  Analysis::setDufortFirstStepMethod(int choice) {
+	DufortFirstStepMethod = choice;
+}
+
+void Analysis::setOutputFormat(int format) {
+	outputFormat = format;
+}
+
+void Analysis::setThreads(int count) {
+	threads = count;
+}
+
+void Analysis::setAdaptiveTolerance(double tol) {
+	adaptiveTolerance = tol;
+}
+
+void Analysis::setSteadyTolerance(double tol) {
+	steadyTolerance = tol;
+}
+
+void Analysis::setPrecision(int choice) {
+	precision = choice;
+}
+
+void Analysis::setStarterSubstep(double fraction) {
+	starterFraction = fraction;
+}
+
+void Analysis::setSymmetric(bool on) {
+	symmetric = on;
+}
+
+int Analysis::getStoppedStep() const {
+	return stoppedStep;
+}
+
+// Methods
+/* similar to:
+type Analysis::initialiseImplicit(type impl) {
+	...;
+	return type;
+}*/
+Implicit Analysis::initialiseImplicit(Implicit impl) {
+	impl.setDeltat(deltat);
+	impl.setDeltax(deltax);
+	impl.setD_value(D_value);
+	impl.setSpaceDomain(int(thickness / deltax)); // space domain set as the integer value of the thickness of the wall divided by the space step.
+	impl.setTimeDomain(int(outputTime / deltat)); // space domain set as the integer value of the thickness of the wall divided by the time step.
+	impl.setT_surf(t_surf);
+	impl.setT_init(t_init);
+	impl.setThreads(threads); // the tridiagonal systems of parallel threshold rows or more are solved by several threads
+	impl.setAdaptive(adaptiveTolerance); // Laasonen and Crank-Nicolson choose their own steps if the tolerance is > 0
+	impl.setSteadyTolerance(steadyTolerance);
+	impl.setPrecision(precision);
+	impl.setOutputTimes(snapshotTimes); // the adaptive march lands on the times of solveAt
+	impl.setSymmetric(symmetric);
+	return impl;
+}
+
+Explicit Analysis::initialiseExplicit(Explicit expl) {
+	expl.setDeltat(deltat);
+	expl.setDeltax(deltax);
+	expl.setD_value(D_value);
+	expl.setSpaceDomain(int(thickness / deltax)); // space domain set as the integer value of the thickness of the wall divided by the space step.
+	expl.setTimeDomain(int(outputTime / deltat)); // space domain set as the integer value of the thickness of the wall divided by the time step.
+	expl.setT_surf(t_surf);
+	expl.setT_init(t_init);
+	expl.setThreads(threads); // the grid is split between the threads when it is large enough
+	expl.setSteadyTolerance(steadyTolerance);
+	expl.setPrecision(precision);
+	expl.setStarterSubstep(starterFraction);
+	expl.setSymmetric(symmetric);
+	return expl;
+}
+
+void Analysis::writeProfile(const string& name, const Vector& v) {
+	if (outputFormat == 2 || outputFormat == 3) { // raw values, written at the disk bandwidth
+		BinaryWriter writer(name + ".bin", v.getSize(), deltax, deltat, outputFormat == 3);
+		writer.write(outputTime, v);
+		writer.close();
+		return;
+	}
+	PROFILE_SCOPE(PhaseOutput);
+	ofstream outfile(name + ".csv");
+	if (outfile.is_open()) {
+		outfile << "x (m)" << "," << "T (K)" << "\n";
+		for (int i = 0; i < int(v.size()); i++) {
+			outfile << fixed << setprecision(4) << (i * deltax) << "," << v[i] << "\n"; // no flush at each line
+		}
+		PROFILE_COUNT(CounterBytesWritten, outfile.tellp());
+		outfile.close();
+	}
+}
+
+void Analysis::printExplicit_duFordFrankel() {
+	//creation and initialisation of an Explicit object
+	Explicit solver;
+	solver = initialiseExplicit(solver);
+	/* solver = initialiseExplicit(solver); ---> this replace all the following arguments:
+	Explicit solver;
+	solver.setDeltat(deltat);
+	solver.setDeltax(deltax);
+	solver.setD_value(D_value);
+	solver.setSpaceDomain(int(thickness / deltax));
+	solver.setTimeDomain(int(outputTime / deltat));
+	solver.setT_surf(t_surf);
+	solver.setT_init(t_init);*/
+	Vector v1 = solver.duFortSolve(DufortFirstStepMethod);
+	writeProfile("duFortFrankel", v1);
+}
+
+void Analysis::printExplicit_richardson() {
+	Explicit solver;
+	solver = initialiseExplicit(solver);
+	Vector v1 = solver.richardsonSolve();
+	writeProfile("Richardson", v1);
+}
+
+void Analysis::printImplicit_laasonen() {
+	Implicit solver;
+	solver = initialiseImplicit(solver);
+	Vector v1 = solver.laasonenSolve();
+	writeProfile("laasonen", v1);
+}
+
+void Analysis::printImplicit_crankNicolson() {
+	Implicit solver;
+	solver = initialiseImplicit(solver);
+	Vector v1 = solver.crankNicolsonSolve();
+	writeProfile("crankNicolson", v1);
+}
+
+Vector Analysis::solve(int numerical_scheme) {
+	return runScheme(numerical_scheme, int(outputTime / deltat), nullptr);
+}
+
+Vector Analysis::exact_solution() {
+	// modal coefficients computed once for the output time and truncated to 1e-10 K, then all the nodes are evaluated by recurrence
+	ExactSolution exact(D_value, thickness, t_surf, t_init);
+	exact.setThreads(threads); // as the solvers: one thread per case within a sweep
+	exact.setSymmetric(symmetric);
+	exact.setTime(outputTime);
+	return exact.evaluate(int(thickness / deltax) + 1, deltax);
+}
+
+void Analysis::print_exact_solution() {
+	Vector v1 = exact_solution();
+	///write the exact solution and return it as well.
+	writeProfile("exact_solution", v1);
+}
+
+Vector Analysis::onTimeGrid(const Vector& times) {
+	Vector grid = times;
+	sort(grid.begin(), grid.end());
+	for (int k = 0; k < grid.getSize(); k++) {
+		grid[k] = max(0.0, round(grid[k] / deltat)) * deltat; // the same value as the time step * deltat given to the observers
+	}
+	return grid;
+}
+
+vector<Vector> Analysis::solveAt(const Vector& times, int numerical_scheme) {
+	vector<Vector> profiles;
+	if (times.getSize() == 0)
+		return profiles;
+	snapshotTimes = onTimeGrid(times);
+	int lastStep = int(round(snapshotTimes[snapshotTimes.getSize() - 1] / deltat));
+	SnapshotRecorder recorder(snapshotTimes, deltat);
+	runScheme(numerical_scheme, lastStep + 1, &recorder); // levels 0 to lastStep
+	snapshotTimes.clear();
+	for (int k = 0; k < recorder.getSnapshotCount(); k++) {
+		profiles.push_back(recorder.getProfile(k));
+	}
+	return profiles;
+}
+
+vector<Vector> Analysis::exactAt(const Vector& times) {
+	Vector grid = onTimeGrid(times);
+	vector<Vector> profiles;
+	ExactSolution exact(D_value, thickness, t_surf, t_init);
+	exact.setThreads(threads); // as the solvers: one thread per case within a sweep
+	exact.setSymmetric(symmetric);
+	for (int k = 0; k < grid.getSize(); k++) {
+		exact.setTime(grid[k]);
+		profiles.push_back(exact.evaluate(int(thickness / deltax) + 1, deltax));
+	}
+	return profiles;
+}
+
+void Analysis::printSnapshots(const Vector& times, int numerical_scheme) {
+	Vector grid = onTimeGrid(times);
+	vector<Vector> numerical = solveAt(grid, numerical_scheme);
+	vector<Vector> exact = exactAt(grid);
+	PROFILE_SCOPE(PhaseOutput);
+	ofstream outfile("snapshots_" + schemeName(numerical_scheme) + ".csv");
+	if (outfile.is_open()) {
+		outfile << "x (m)";
+		for (int k = 0; k < int(numerical.size()); k++) {
+			outfile << "," << "T (K) at t = " << grid[k] << "," << "exact at t = " << grid[k] << "," << "error at t = " << grid[k];
+		}
+		outfile << "\n";
+		for (int i = 0; i <= int(thickness / deltax); i++) {
+			outfile << fixed << setprecision(4) << (i * deltax);
+			for (int k = 0; k < int(numerical.size()); k++) {
+				outfile << "," << numerical[k][i] << "," << exact[k][i] << "," << abs(numerical[k][i] - exact[k][i]);
+			}
+			outfile << "\n";
+		}
+		PROFILE_COUNT(CounterBytesWritten, outfile.tellp());
+		outfile.close();
+	}
+}
+
+void Analysis::printSnapshots(double every, int numerical_scheme) {
+	Vector times;
+	for (int k = 1; every > 0 && k * every <= outputTime * (1 + 1e-12); k++) {
+		times.push_back(k * every);
+	}
+	printSnapshots(times, numerical_scheme);
+}
+
+Vector Analysis::printErrors(int numerical_scheme) {
+	Vector v1 = exact_solution();
+	Vector v2;
+	Vector errors(v1.size());
+	string file;
+
+	Explicit expl;
+	expl = initialiseExplicit(expl);
+	Implicit impl;
+	impl = initialiseImplicit(impl);
+	
+	// for the numerical numerical_scheme chosen, write the errors in a .csv file, and return them as well
+	switch (numerical_scheme) {
+		case 1: {
+			v2 = expl.duFortSolve(DufortFirstStepMethod);
+			file = "errors_duFort.csv";
+			break;
+		}
+		case 2: {
+			v2 = expl.richardsonSolve();
+			file = "errors_richardson.csv";
+			break;
+		}
+		case 3: {
+			v2 = impl.laasonenSolve();
+			file = "errors_laasonen.csv";
+			break;
+		}
+		case 4: {
+			v2 = impl.crankNicolsonSolve();
+			file = "errors_crankNicolson.csv";
+			break;
+		}
+	}
+
+	PROFILE_SCOPE(PhaseOutput);
+	ofstream outfile(file);
+	if (outfile.is_open()) {
+		outfile << "x (m)" << "," << "Error" << "\n";
+		for (int i = 0; i < int(v1.size()); i++) {
+			errors[i] = abs(v1[i] - v2[i]);
+			outfile << (i * deltax) << "," << errors[i] << "\n";
+		}
+		PROFILE_COUNT(CounterBytesWritten, outfile.tellp());
+		outfile.close(); 
+	}
+	return errors;
+}
+
+Vector Analysis::runScheme(int numerical_scheme, int timeSteps, StepObserver* observer) {
+	Vector v1;
+	Explicit expl;
+	expl = initialiseExplicit(expl);
+	Implicit impl;
+	impl = initialiseImplicit(impl);
+	if (observer != nullptr) {
+		expl.addObserver(observer);
+		impl.addObserver(observer);
+	}
+	expl.setTimeDomain(timeSteps);
+	impl.setTimeDomain(timeSteps);
+
+	switch (numerical_scheme) {
+		case 1: {
+			v1 = expl.duFortSolve(DufortFirstStepMethod);
+			break;
+		}
+		case 2: {
+			v1 = expl.richardsonSolve();
+			break;
+		}
+		case 3: {
+			v1 = impl.laasonenSolve();
+			break;
+		}
+		case 4: {
+			v1 = impl.crankNicolsonSolve();
+			break;
+		}
+	}
+	stoppedStep = (numerical_scheme <= 2) ? expl.getStoppedStep() : impl.getStoppedStep(); // read with getStoppedStep
+	return v1;
+}
+
+string Analysis::schemeName(int numerical_scheme) {
+	switch (numerical_scheme) {
+		case 1:
+			return "duFort";
+		case 2:
+			return "richardson";
+		case 3:
+			return "laasonen";
+		case 4:
+			return "crankNicolson";
+	}
+	return "unknown";
+}
+
+void Analysis::printTimeFunction(double positionToSee, double timeToSee, int numerical_scheme) {
+	// for the numerical_scheme chosen (int numerical_scheme), evolution of the temperature at x = positionToSee in time until t=timeToSee
+	int time = int(timeToSee / deltat);
+
+	// check wether the node we are looking at is inside the domain
+	if (positionToSee <= thickness) {
+		// a single time march, the probe being read at every time level (time + 1 levels: from t = 0 to t = time * deltat)
+		Vector position(1);
+		position[0] = positionToSee;
+		ProbeRecorder probe(position, deltax, int(thickness / deltax) + 1, 1);
+		runScheme(numerical_scheme, time + 1, &probe);
+
+		PROFILE_SCOPE(PhaseOutput);
+		ofstream outfile("timeFunction_" + schemeName(numerical_scheme) + ".csv");
+		if (outfile.is_open()) {
+			outfile << "At x = " << positionToSee << "\n";
+			outfile << "t (s)" << "," << "T (K)" << "\n";
+			for (int i = 0; i < probe.getSampleCount() && i <= time; i++) {
+				outfile << probe.getTime(i) << fixed << setprecision(4) << "," << probe.getValue(i, 0) << "\n";
+			}
+			PROFILE_COUNT(CounterBytesWritten, outfile.tellp());
+			outfile.close(); 
+		}
+	}
+	else
+		cout << "The value of x chosen is out of borders!" << endl;
+}
+
+void Analysis::printHistory(double timeToSee, int numerical_scheme, int every) {
+	// the levels are handed over to the background writer during the time march, only a few snapshot buffers are kept in memory
+	string file = "history_" + schemeName(numerical_scheme) + ((outputFormat == 2 || outputFormat == 3) ? ".bin" : ".csv");
+	AsyncWriter writer(file, outputFormat, int(thickness / deltax) + 1, deltax, deltat, every);
+	runScheme(numerical_scheme, int(timeToSee / deltat) + 1, &writer);
+	writer.close();
+}
+
+void Analysis::printProbes(Vector positionsToSee, double timeToSee, int numerical_scheme, int every) {
+	// check wether the probes are inside the domain
+	for (int p = 0; p < positionsToSee.getSize(); p++) {
+		if (positionsToSee[p] < 0 || positionsToSee[p] > thickness) {
+			cout << "The value of x chosen is out of borders!" << endl;
+			return;
+		}
+	}
+	ProbeRecorder probes(positionsToSee, deltax, int(thickness / deltax) + 1, every);
+	runScheme(numerical_scheme, int(timeToSee / deltat) + 1, &probes);
+	probes.write("probes_" + schemeName(numerical_scheme) + ".csv");
+}
+
+void Analysis::printParallelEfficiency(int numerical_scheme, int maxThreads) {
+	int savedThreads = threads;
+	double reference = 0; // time with one thread
+	ofstream outfile("parallelEfficiency_" + schemeName(numerical_scheme) + ".csv");
+	if (outfile.is_open()) {
+		outfile << "threads" << "," << "time (s)" << "," << "speedup" << "," << "efficiency" << "\n";
+		for (int count = 1; count <= maxThreads; count *= 2) {
+			threads = count;
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			solve(numerical_scheme);
+			double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			if (count == 1)
+				reference = time;
+			outfile << count << "," << time << "," << reference / time << "," << reference / time / count << "\n";
+		}
+		outfile.close();
+	}
+	threads = savedThreads;
+}
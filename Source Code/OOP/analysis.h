@@ -1,71 +1,133 @@
-/***********************************************************************\
-#                                                                       #
-#                C R A N F I E L D   U N I V E R S I T Y                #
-#                          2 0 1 9  /  2 0 2 0                          #
-#                                                                       #
-#               MSc in Aerospace Computational Engineering              #
-#                                                                       #
-#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
-#                                                                       #
-#-----------------------------------------------------------------------#
-#                                                                       #
-#   Main Contributors:                                                  #
-#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
-#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
-#                                                                       #
-\***********************************************************************/
-
-
-#ifndef ANALYSIS_H
-#define ANALYSIS_H
-#include "explicit.h"  // we use Explicit objects in Analysis code
-#include "implicit.h"  // we use Implicit objects in Analysis code
-
-
-class Analysis {
-	// Atributes
-	private:
-		double D_value, deltax, deltat, thickness, outputTime, t_surf, t_init; // respectively: diffusion coefficient, space step, time step, time which ,temperature of the sides, initial temperature 
-		int DufortFirstStepMethod; // this integer will define witch method to use for getting the solution at the first time step of the Dufort-Frankel scheme
-	
-	public:
-		// Default contructor
-		Analysis(double Diff, double dx, double dt, double thick, double output_Time, double T_surf, double T_init, int choice_duFort);
-		
-		// Get & Set methods
-		void setD_value(double D);
-		void setDeltax(double x);
-		void setDeltat(double t);
-		void setThickness(double L);
-		void setOutputTime(double outTime);
-		void setT_surf(double Tsurf);
-		void setT_init(double Tinit);
-		void setDufortFirstStepMethod(int choice);
-		
-		// Methods
-		Implicit initialiseImplicit(Implicit impl); // initialise the implicit object, especially define discret time and space domain
-		Explicit initialiseExplicit(Explicit expl); // initialise the Explicit object, especially define discret time and space domain
-		
-		// write in a .csv file, the numerical solution at each node, using the Dufort-Frankel scheme, for a CONSTANT t chosen
-		void printExplicit_duFordFrankel();
-		
-		// write in a .csv file, the numerical solution at each node, using the Richardson scheme, for a CONSTANT t chosen		
-		void printExplicit_richardson();
-		
-		// write in a .csv file, the numerical solution at each node, using the Laasonen simple implicit scheme, for a CONSTANT t chosen
-		void printImplicit_laasonen();
-		
-		// write in a .csv file, the numerical solution at each node, using the CrankNicolson scheme, for a CONSTANT t chosen
-		void printImplicit_crankNicolson();
-		
-		// analytic solution for each nodes at the time we're looking for, in order to compare it with numerical solutions(errors)	
-		Vector exact_solution();
-		void print_exact_solution();
-		
-		// show the errors i.e. absolute difference betwteen numerical values and analytic values at each nodes
-		Vector printErrors(int numerical_scheme);
-	
-		// write in a .csv file, the numerical solution at each time step until the duration chosen is reached, using a chosen numerical scheme, for a CONSTANT x
-		void printTimeFunction(double positionToSee, double timeToSee, int numerical_scheme);
-};
-#endif
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+#include "explicit.h"  // we use Explicit objects in Analysis code
+#include "implicit.h"  // we use Implicit objects in Analysis code
+#include "probe.h"     // time histories are recorded by probes during a single time march
+#include "snapshot.h"  // profiles at several times recorded during a single time march
+#include "exact.h"     // analytic solution used as the reference
+#include "binaryio.h"  // binary result files
+#include "asyncwriter.h" // time histories are written by a background thread
+#include <string>
+
+
+class Analysis {
+	// Atributes
+	private:
+		double D_value, deltax, deltat, thickness, outputTime, t_surf, t_init; // respectively: diffusion coefficient, space step, time step, time which ,temperature of the sides, initial temperature 
+		int DufortFirstStepMethod; // this integer will define witch method to use for getting the solution at the first time step of the Dufort-Frankel scheme
+		int outputFormat; // format of the solution files: 1: .csv text (default), 2: .bin binary float64, 3: .bin binary float32
+		int threads; // threads used by the solvers on the large grids (1 by default: serial)
+		double adaptiveTolerance; // local error accepted per step by the adaptive implicit schemes (K), 0 by default: uniform steps
+		double steadyTolerance; // change per time step under which the solvers stop on the steady state (K), 0 by default: never
+		int precision; // precision of the solvers: 1: double (default), 2: float, 3: float storage and double arithmetic
+		double starterFraction; // sub-steps of the DuFort-Frankel start method 4, as a fraction of the FTCS stability limit (0.5 by default)
+		bool symmetric; // solvers and exact solution on the half of the wall up to the centreline (false by default)
+		int stoppedStep; // time step at which the last run of runScheme reached the steady state, -1 if it went to the end
+		Vector snapshotTimes; // times the adaptive march has to land on during solveAt (empty otherwise)
+
+		// write a temperature profile in the output format chosen, in the file "name" + .csv or .bin
+		void writeProfile(const std::string& name, const Vector& v);
+
+		// march once with the numerical scheme chosen until the time level "timeSteps" - 1, notifying the observer (if any) at each time level
+		Vector runScheme(int numerical_scheme, int timeSteps, StepObserver* observer);
+
+		// name of the numerical scheme used in the .csv file names
+		std::string schemeName(int numerical_scheme);
+
+		// the times given, sorted and moved to the nearest time level (multiple of deltat, not before t = 0)
+		Vector onTimeGrid(const Vector& times);
+	
+	public:
+		// Default contructor
+		Analysis(double Diff, double dx, double dt, double thick, double output_Time, double T_surf, double T_init, int choice_duFort);
+		
+		// Get & Set methods
+		void setD_value(double D);
+		void setDeltax(double x);
+		void setDeltat(double t);
+		void setThickness(double L);
+		void setOutputTime(double outTime);
+		void setT_surf(double Tsurf);
+		void setT_init(double Tinit);
+		void setDufortFirstStepMethod(int choice);
+		void setOutputFormat(int format);
+		void setThreads(int count);
+		void setAdaptiveTolerance(double tol);
+		void setSteadyTolerance(double tol);
+		void setPrecision(int choice);
+		void setStarterSubstep(double fraction);
+		void setSymmetric(bool on); // see Explicit::setSymmetric, Implicit::setSymmetric and ExactSolution::setSymmetric
+		int getStoppedStep() const; // time step at which the last solve stopped on the steady state, -1 if it went to the output time
+		
+		// Methods
+		Implicit initialiseImplicit(Implicit impl); // initialise the implicit object, especially define discret time and space domain
+		Explicit initialiseExplicit(Explicit expl); // initialise the Explicit object, especially define discret time and space domain
+		
+		// write in a .csv file, the numerical solution at each node, using the Dufort-Frankel scheme, for a CONSTANT t chosen
+		void printExplicit_duFordFrankel();
+		
+		// write in a .csv file, the numerical solution at each node, using the Richardson scheme, for a CONSTANT t chosen		
+		void printExplicit_richardson();
+		
+		// write in a .csv file, the numerical solution at each node, using the Laasonen simple implicit scheme, for a CONSTANT t chosen
+		void printImplicit_laasonen();
+		
+		// write in a .csv file, the numerical solution at each node, using the CrankNicolson scheme, for a CONSTANT t chosen
+		void printImplicit_crankNicolson();
+		
+		// numerical solution at each node at the output time, using the numerical scheme chosen (1: DuFort-Frankel, 2: Richardson, 3: Laasonen, 4: Crank-Nicolson), without writing any file
+		Vector solve(int numerical_scheme);
+
+		// analytic solution for each nodes at the time we're looking for, in order to compare it with numerical solutions(errors)	
+		Vector exact_solution();
+		void print_exact_solution();
+
+		// numerical solution at each node at several times, all taken during ONE time march until the last time (instead of one march per time).
+		// The times are sorted and moved to the nearest time level, the solution at the time k is returned at [k]
+		std::vector<Vector> solveAt(const Vector& times, int numerical_scheme);
+
+		// analytic solution at the same times as solveAt (moved to the nearest time level), at [k] for the time k
+		std::vector<Vector> exactAt(const Vector& times);
+
+		// write in snapshots_<scheme>.csv the numerical solution of solveAt, the exact solution and the error at every node, three columns per time
+		void printSnapshots(const Vector& times, int numerical_scheme);
+
+		// same as above at a fixed cadence: t = every, 2 every, ... until the output time
+		void printSnapshots(double every, int numerical_scheme);
+		
+		// show the errors i.e. absolute difference betwteen numerical values and analytic values at each nodes
+		Vector printErrors(int numerical_scheme);
+	
+		// write in a .csv file, the numerical solution at each time step until the duration chosen is reached, using a chosen numerical scheme, for a CONSTANT x
+		void printTimeFunction(double positionToSee, double timeToSee, int numerical_scheme);
+
+		// write in a file the numerical solution at every node, every "every" time steps until t=timeToSee, using a chosen numerical scheme.
+		// The file (.csv, or .bin float64/float32 depending on the output format) is written by a background thread while the solver keeps stepping
+		void printHistory(double timeToSee, int numerical_scheme, int every);
+
+		// time the numerical scheme chosen with 1, 2, 4... up to maxThreads threads, and write the speedup and the parallel efficiency
+		// (speedup / threads) of each run in parallelEfficiency_<scheme>.csv
+		void printParallelEfficiency(int numerical_scheme, int maxThreads);
+
+		// same as printTimeFunction, but for any number of positions (on or between the nodes) recorded during the same time march, every "every" time steps
+		void printProbes(Vector positionsToSee, double timeToSee, int numerical_scheme, int every);
+};
+#endif
@@ -0,0 +1,141 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "asyncwriter.h"
+#include "profiler.h"
+#include <chrono>
+#include <iomanip>
+using namespace std;
+
+
+// wait politely: spin a little (the other side is usually about to move), then yield, then sleep
+static void backOff(int& attempts) {
+	attempts++;
+	if (attempts < 64)
+		return;
+	if (attempts < 256)
+		this_thread::yield();
+	else
+		this_thread::sleep_for(chrono::microseconds(50));
+}
+
+
+// Default constructor
+AsyncWriter::AsyncWriter(const string& fileName, int outputFormat, int nodeCount, double dx, double dt, int k, int bufferCount) {
+	nodes = nodeCount;
+	every = (k < 1) ? 1 : k;
+	depth = (bufferCount < 2) ? 2 : bufferCount;
+	format = outputFormat;
+	deltax = dx;
+	buffers.assign(depth, Vector(nodes));
+	times = Vector(depth);
+	head = 0;
+	tail = 0;
+	finished = false;
+	stalls = 0;
+
+	if (format == 2 || format == 3)
+		binary.reset(new BinaryWriter(fileName, nodes, dx, dt * every, format == 3));
+	else {
+		text.open(fileName);
+		if (text.is_open()) {
+			text << "t (s)";
+			for (int i = 0; i < nodes; i++) {
+				text << "," << "x = " << fixed << setprecision(4) << (i * deltax);
+			}
+			text << "\n";
+		}
+	}
+	worker = thread(&AsyncWriter::run, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+	close();
+}
+
+// Get method
+long long AsyncWriter::getStalls() const {
+	return stalls;
+}
+
+// Methods
+void AsyncWriter::observe(int step, double time, const Vector& level) {
+	if (step % every != 0)
+		return;
+
+	// back-pressure: wait for the background thread to free a buffer
+	long long h = head.load(memory_order_relaxed);
+	if (h - tail.load(memory_order_acquire) >= depth) {
+		stalls++;
+		int attempts = 0;
+		while (h - tail.load(memory_order_acquire) >= depth) {
+			backOff(attempts);
+		}
+	}
+
+	// fill the buffer (allocated once, so no allocation here) then publish it
+	Vector& buffer = buffers[h % depth];
+	for (int i = 0; i < nodes; i++) {
+		buffer[i] = level[i];
+	}
+	times[h % depth] = time;
+	head.store(h + 1, memory_order_release);
+}
+
+void AsyncWriter::run() {
+	int attempts = 0;
+	while (true) {
+		long long t = tail.load(memory_order_relaxed);
+		if (t == head.load(memory_order_acquire)) { // nothing to write
+			if (finished.load(memory_order_acquire) && t == head.load(memory_order_acquire))
+				return;
+			backOff(attempts);
+			continue;
+		}
+		attempts = 0;
+		writeSnapshot(times[t % depth], buffers[t % depth]);
+		tail.store(t + 1, memory_order_release); // the buffer can be reused by the solver
+	}
+}
+
+void AsyncWriter::writeSnapshot(double time, const Vector& level) {
+	if (binary) {
+		binary->write(time, level);
+	}
+	else if (text.is_open()) {
+		PROFILE_SCOPE(PhaseOutput);
+		text << fixed << setprecision(4) << time;
+		for (int i = 0; i < nodes; i++) {
+			text << "," << level[i];
+		}
+		text << "\n";
+	}
+}
+
+void AsyncWriter::close() {
+	if (!worker.joinable())
+		return;
+	finished.store(true, memory_order_release);
+	worker.join();
+	if (binary)
+		binary->close();
+	if (text.is_open()) {
+		PROFILE_COUNT(CounterBytesWritten, text.tellp());
+		text.close();
+	}
+}
@@ -0,0 +1,75 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef ASYNCWRITER_H
+#define ASYNCWRITER_H
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "binaryio.h" // binary records, written by the background thread
+
+
+// Snapshot writer running in a background thread, plugged into any of the four schemes as a StepObserver.
+// The solver thread only copies the time level into one of "depth" buffers allocated once, and goes on stepping;
+// the background thread formats (.csv) or converts (float32 .bin) the snapshots and writes them to the disk.
+// The buffers form a bounded single-producer/single-consumer ring, synchronised by two atomic counters only (lock-free).
+// When the ring is full the solver waits for the writer (back-pressure), so the memory used stays bounded.
+class AsyncWriter : public StepObserver {
+	// Attributes
+	private:
+		int nodes, every, depth; // respectively: nodes of a snapshot, a snapshot is taken every "every" steps, number of buffers
+		int format; // 1: .csv text, 2: .bin float64, 3: .bin float32
+		double deltax;
+		std::vector<Vector> buffers; // the ring of snapshots
+		Vector times; // time of the snapshot stored in each buffer
+		std::atomic<long long> head; // number of snapshots handed over by the solver
+		std::atomic<long long> tail; // number of snapshots written by the background thread
+		std::atomic<bool> finished; // no more snapshots will be handed over
+		long long stalls; // number of snapshots for which the solver had to wait for a free buffer
+		std::unique_ptr<BinaryWriter> binary; // file of the binary formats
+		std::ofstream text; // file of the .csv format
+		std::thread worker;
+
+		// main loop of the background thread
+		void run();
+
+		// format and write one snapshot (background thread)
+		void writeSnapshot(double time, const Vector& level);
+
+	public:
+		// Default contructor: opens "fileName" and starts the background thread
+		AsyncWriter(const std::string& fileName, int format, int nodes, double dx, double dt, int every = 1, int depth = 8);
+		AsyncWriter(const AsyncWriter&) = delete; // owns a thread
+		AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+		// flushes the snapshots left and stops the thread if close was not called
+		~AsyncWriter();
+
+		// Get method
+		long long getStalls() const;
+
+		// Methods
+		// called by the solvers at each time level: copy the level into a free buffer and return immediately
+		void observe(int step, double time, const Vector& level);
+
+		// wait until every snapshot is written, stop the background thread and close the file
+		void close();
+};
+#endif
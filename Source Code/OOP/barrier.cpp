@@ -0,0 +1,44 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "barrier.h"
+#include <thread>
+using namespace std;
+
+
+// Default constructor
+SpinBarrier::SpinBarrier(int threads) {
+	count = threads;
+	arrived = 0;
+	generation = 0;
+}
+
+// Methods
+void SpinBarrier::wait() {
+	int current = generation.load(memory_order_acquire);
+	if (arrived.fetch_add(1, memory_order_acq_rel) == count - 1) { // last one: open the barrier for the others
+		arrived.store(0, memory_order_relaxed);
+		generation.fetch_add(1, memory_order_release);
+		return;
+	}
+	int spins = 0;
+	while (generation.load(memory_order_acquire) == current) {
+		if (++spins > 1000)
+			this_thread::yield();
+	}
+}
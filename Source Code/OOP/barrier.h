@@ -0,0 +1,41 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef BARRIER_H
+#define BARRIER_H
+#include <atomic>
+
+
+// Barrier for a fixed group of threads synchronised at every time step: the threads spin on an atomic counter
+// (no system call when they arrive together), then yield the core if they wait for long, so that more threads than cores still progress.
+class SpinBarrier {
+	// Attributes
+	private:
+		int count; // threads of the group
+		std::atomic<int> arrived; // threads waiting at the current barrier
+		std::atomic<int> generation; // incremented each time the barrier opens
+
+	public:
+		// Default contructor: barrier for "threads" threads
+		explicit SpinBarrier(int threads);
+
+		// Methods
+		// block until the "count" threads have called wait; the writes done before wait are visible to all the threads after it
+		void wait();
+};
+#endif
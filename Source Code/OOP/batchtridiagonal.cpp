@@ -0,0 +1,91 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "batchtridiagonal.h"
+
+
+// Default constructor
+BatchTridiagonal::BatchTridiagonal() {
+	systems = 0;
+	rows = 0;
+}
+
+// Get methods
+int BatchTridiagonal::getSystems() const {
+	return systems;
+}
+
+int BatchTridiagonal::getRows() const {
+	return rows;
+}
+
+// Methods
+void BatchTridiagonal::factorise(int K, int n, const Vector& a, const Vector& b, const Vector& c) {
+	systems = K;
+	rows = n;
+	lower = a;
+	upper.refill(n * K, 0.0);
+	pivot.refill(n * K, 0.0);
+
+	// same elimination as Tridiagonal::factorise, row after row, for all the systems at once.
+	// The rows are distinct slices of the arrays: __restrict lets the compiler vectorise the loops over k without alias checks
+	for (int k = 0; k < K; k++) {
+		pivot[k] = 1 / b[k];
+		upper[k] = c[k] * pivot[k];
+	}
+	for (int i = 1; i < n; i++) {
+		const double* __restrict ai = &a[i * K];
+		const double* __restrict bi = &b[i * K];
+		const double* __restrict ci = &c[i * K];
+		const double* __restrict up = &upper[(i - 1) * K];
+		double* __restrict ui = &upper[i * K];
+		double* __restrict piv = &pivot[i * K];
+		for (int k = 0; k < K; k++) {
+			piv[k] = 1 / (bi[k] - up[k] * ai[k]);
+			ui[k] = ci[k] * piv[k];
+		}
+	}
+}
+
+void BatchTridiagonal::solve(Vector& d) const {
+	int K = systems;
+	int n = rows;
+
+	// forward substitution
+	for (int k = 0; k < K; k++) {
+		d[k] *= pivot[k];
+	}
+	for (int i = 1; i < n; i++) {
+		const double* __restrict ai = &lower[i * K];
+		const double* __restrict piv = &pivot[i * K];
+		const double* __restrict dp = &d[(i - 1) * K];
+		double* __restrict di = &d[i * K];
+		for (int k = 0; k < K; k++) {
+			di[k] = (di[k] - dp[k] * ai[k]) * piv[k];
+		}
+	}
+	// back substitution
+	for (int i = n - 2; i >= 0; i--) {
+		const double* __restrict ui = &upper[i * K];
+		const double* __restrict dn = &d[(i + 1) * K];
+		double* __restrict di = &d[i * K];
+		for (int k = 0; k < K; k++) {
+			di[k] -= ui[k] * dn[k];
+		}
+	}
+}
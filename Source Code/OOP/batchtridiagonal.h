@@ -0,0 +1,51 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef BATCHTRIDIAGONAL_H
+#define BATCHTRIDIAGONAL_H
+#include "vector.h"
+
+
+// K independent tridiagonal systems of the same size n, factorised once and solved together.
+// The coefficients and the right hand sides are interleaved (structure of arrays): the row i of the system k is stored at [i * K + k].
+// The Thomas recurrence is sequential along i, but each of its steps is applied to the K systems by a contiguous loop over k,
+// which the compiler vectorises (SSE/AVX2/AVX-512 lanes depending on the target instruction set).
+class BatchTridiagonal {
+	// Attributes
+	private:
+		int systems, rows; // respectively: number of systems K, number of rows n of each system
+		Vector lower; // lower diagonals a_i (a_0 is not used)
+		Vector upper; // modified upper diagonals c'_i
+		Vector pivot; // reciprocal pivots
+
+	public:
+		// Default contructor: empty batch, factorise has to be called before solve
+		BatchTridiagonal();
+
+		// Get methods
+		int getSystems() const;
+		int getRows() const;
+
+		// Methods
+		// factorise the K systems of n rows, a, b and c being interleaved diagonals of size n * K
+		void factorise(int K, int n, const Vector& a, const Vector& b, const Vector& c);
+
+		// solve the K systems for the interleaved right hand sides d (size n * K), the solutions are written in d
+		void solve(Vector& d) const;
+};
+#endif
@@ -0,0 +1,269 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "binaryio.h"
+#include "profiler.h"
+#include <cstring>
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+
+static const char binaryMagic[8] = { 'H', 'E', 'A', 'T', '1', 'D', 'B', '\0' };
+static const uint32_t binaryVersion = 1;
+
+
+bool isLittleEndian() {
+	uint16_t one = 1;
+	unsigned char first;
+	memcpy(&first, &one, 1);
+	return first == 1;
+}
+
+// reverse the bytes of count values of size bytes (only used on big-endian machines)
+static void swapBytes(void* values, size_t bytes, size_t count) {
+	unsigned char* p = static_cast<unsigned char*>(values);
+	for (size_t k = 0; k < count; k++, p += bytes) {
+		for (size_t i = 0; i < bytes / 2; i++) {
+			unsigned char c = p[i];
+			p[i] = p[bytes - 1 - i];
+			p[bytes - 1 - i] = c;
+		}
+	}
+}
+
+// swap the header fields so that the file is little-endian whatever the machine
+static void swapHeader(BinaryHeader& h) {
+	swapBytes(&h.version, 4, 2);
+	swapBytes(&h.nodes, 8, 2);
+	swapBytes(&h.deltax, 8, 3);
+	swapBytes(&h.reserved, 8, 1);
+}
+
+
+// Default constructor
+BinaryWriter::BinaryWriter(const string& fileName, int nodes, double dx, double dt, bool singlePrecision, int k) {
+	memcpy(header.magic, binaryMagic, 8);
+	header.version = binaryVersion;
+	header.valueBytes = singlePrecision ? 4 : 8;
+	header.nodes = nodes;
+	header.records = 0;
+	header.deltax = dx;
+	header.x0 = 0;
+	header.deltat = dt;
+	header.reserved = 0;
+	every = (k < 1) ? 1 : k;
+	if (singlePrecision)
+		buffer.resize(nodes);
+
+	file = fopen(fileName.c_str(), "wb");
+	if (file != nullptr) {
+		setvbuf(file, nullptr, _IOFBF, 1 << 20); // large buffer: the records are written at the disk bandwidth
+		BinaryHeader h = header;
+		if (!isLittleEndian())
+			swapHeader(h);
+		fwrite(&h, sizeof(h), 1, file);
+	}
+}
+
+BinaryWriter::~BinaryWriter() {
+	close();
+}
+
+// Get method
+bool BinaryWriter::isOpen() const {
+	return file != nullptr;
+}
+
+// Methods
+void BinaryWriter::writeValues(const double* values, int count) {
+	if (isLittleEndian()) {
+		fwrite(values, sizeof(double), count, file);
+	}
+	else {
+		Vector swapped(count);
+		memcpy(swapped.data(), values, count * sizeof(double));
+		swapBytes(swapped.data(), sizeof(double), count);
+		fwrite(swapped.data(), sizeof(double), count, file);
+	}
+}
+
+void BinaryWriter::write(double time, const Vector& level) {
+	if (file == nullptr)
+		return;
+	PROFILE_SCOPE(PhaseOutput);
+	writeValues(&time, 1);
+	if (header.valueBytes == 4) {
+		for (int i = 0; i < int(header.nodes); i++) {
+			buffer[i] = float(level[i]);
+		}
+		if (!isLittleEndian())
+			swapBytes(buffer.data(), sizeof(float), buffer.size());
+		fwrite(buffer.data(), sizeof(float), header.nodes, file);
+	}
+	else
+		writeValues(level.data(), int(header.nodes));
+	header.records++;
+}
+
+void BinaryWriter::observe(int step, double time, const Vector& level) {
+	if (step % every == 0)
+		write(time, level);
+}
+
+void BinaryWriter::close() {
+	if (file == nullptr)
+		return;
+	// the number of records is only known now: rewrite the header
+	PROFILE_COUNT(CounterBytesWritten, sizeof(header) + header.records * (8 + header.nodes * header.valueBytes));
+	BinaryHeader h = header;
+	if (!isLittleEndian())
+		swapHeader(h);
+	fseek(file, 0, SEEK_SET);
+	fwrite(&h, sizeof(h), 1, file);
+	fclose(file);
+	file = nullptr;
+}
+
+
+// Default constructor
+MappedResult::MappedResult(const string& fileName) {
+	data = nullptr;
+	length = 0;
+#ifdef _WIN32
+	fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		throw runtime_error("cannot open " + fileName);
+	LARGE_INTEGER size;
+	GetFileSizeEx(fileHandle, &size);
+	length = size_t(size.QuadPart);
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle != nullptr)
+		data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) {
+		if (mappingHandle != nullptr)
+			CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		throw runtime_error("cannot map " + fileName);
+	}
+#else
+	fileDescriptor = open(fileName.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+		throw runtime_error("cannot open " + fileName);
+	struct stat status;
+	fstat(fileDescriptor, &status);
+	length = size_t(status.st_size);
+	void* p = (length > 0) ? mmap(nullptr, length, PROT_READ, MAP_SHARED, fileDescriptor, 0) : MAP_FAILED;
+	if (p == MAP_FAILED) {
+		::close(fileDescriptor);
+		throw runtime_error("cannot map " + fileName);
+	}
+	data = static_cast<const unsigned char*>(p);
+#endif
+	header = reinterpret_cast<const BinaryHeader*>(data);
+	if (length < sizeof(BinaryHeader) || memcmp(header->magic, binaryMagic, 8) != 0 || !isLittleEndian()) {
+		unmap();
+		throw runtime_error(fileName + " is not a binary result file (or the machine is not little-endian)");
+	}
+	recordBytes = sizeof(double) + size_t(header->nodes) * header->valueBytes;
+	if (length < sizeof(BinaryHeader) + recordBytes * header->records) {
+		unmap();
+		throw runtime_error(fileName + " is truncated");
+	}
+}
+
+MappedResult::~MappedResult() {
+	unmap();
+}
+
+void MappedResult::unmap() {
+	if (data == nullptr)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+#else
+	munmap(const_cast<unsigned char*>(data), length);
+	::close(fileDescriptor);
+#endif
+	data = nullptr;
+}
+
+// Get methods
+int MappedResult::getNodes() const {
+	return int(header->nodes);
+}
+
+int MappedResult::getRecords() const {
+	return int(header->records);
+}
+
+double MappedResult::getDeltax() const {
+	return header->deltax;
+}
+
+double MappedResult::getDeltat() const {
+	return header->deltat;
+}
+
+bool MappedResult::isSinglePrecision() const {
+	return header->valueBytes == 4;
+}
+
+double MappedResult::getTime(int record) const {
+	double t;
+	memcpy(&t, data + sizeof(BinaryHeader) + record * recordBytes, sizeof(double)); // the records of float32 values are not always 8-byte aligned
+	return t;
+}
+
+double MappedResult::getValue(int record, int node) const {
+	const unsigned char* p = data + sizeof(BinaryHeader) + record * recordBytes + sizeof(double) + size_t(node) * header->valueBytes;
+	if (isSinglePrecision()) {
+		float value;
+		memcpy(&value, p, sizeof(float));
+		return value;
+	}
+	double value;
+	memcpy(&value, p, sizeof(double));
+	return value;
+}
+
+// Methods
+Vector MappedResult::readRecord(int record, int firstNode, int lastNode) const {
+	Vector v(lastNode - firstNode);
+	for (int i = firstNode; i < lastNode; i++) {
+		v[i - firstNode] = getValue(record, i);
+	}
+	return v;
+}
+
+Vector MappedResult::readNode(int node, int firstRecord, int lastRecord) const {
+	Vector v(lastRecord - firstRecord);
+	for (int r = firstRecord; r < lastRecord; r++) {
+		v[r - firstRecord] = getValue(r, node);
+	}
+	return v;
+}
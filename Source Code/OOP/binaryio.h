@@ -0,0 +1,130 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef BINARYIO_H
+#define BINARYIO_H
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "observer.h" // a BinaryWriter can be plugged into the solvers to record a time history
+
+
+// Binary result file (.bin): a self-describing header followed by raw little-endian records.
+//
+//   header (64 bytes): char magic[8] = "HEAT1DB", uint32 version, uint32 bytes per value (4: float32, 8: float64),
+//                      uint64 nodes, uint64 records, double deltax, double x0, double deltat, uint64 reserved
+//   record r:          double time, then the temperature at the nodes 0 ... nodes - 1
+//
+// A snapshot is a file of one record, a time history a file of many records. Since every record has the same size,
+// a node or a range of time can be read directly at its offset, without parsing the whole file.
+struct BinaryHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t valueBytes;
+	uint64_t nodes;
+	uint64_t records;
+	double deltax, x0, deltat;
+	uint64_t reserved;
+};
+static_assert(sizeof(BinaryHeader) == 64, "the header of the binary files is 64 bytes");
+
+
+class BinaryWriter : public StepObserver {
+	// Attributes
+	private:
+		FILE* file;
+		BinaryHeader header;
+		int every; // when used as an observer, a record is written every "every" time steps
+		std::vector<float> buffer; // conversion buffer of the float32 records, allocated once
+
+		// write count values at the end of the file, little-endian
+		void writeValues(const double* values, int count);
+
+	public:
+		// Default contructor: open "fileName" for records of "nodes" nodes, stored as float32 if singlePrecision
+		BinaryWriter(const std::string& fileName, int nodes, double dx, double dt, bool singlePrecision = false, int k = 1);
+		BinaryWriter(const BinaryWriter&) = delete; // the file is owned by a single writer
+		BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+		// the file is closed (and its header completed) if close was not called
+		~BinaryWriter();
+
+		// Get method
+		bool isOpen() const;
+
+		// Methods
+		// append one record: the temperature at every node at the time "time"
+		void write(double time, const Vector& level);
+
+		// called by the solvers at each time level
+		void observe(int step, double time, const Vector& level);
+
+		// write the number of records in the header and close the file
+		void close();
+};
+
+
+// Read-only view of a binary result file, mapped in memory: opening is immediate whatever the size of the file,
+// and only the pages of the nodes and records actually read are loaded from the disk.
+class MappedResult {
+	// Attributes
+	private:
+		const unsigned char* data; // start of the mapping
+		size_t length; // size of the mapping (bytes)
+		const BinaryHeader* header;
+		size_t recordBytes; // size of one record (bytes)
+#ifdef _WIN32
+		void* fileHandle;
+		void* mappingHandle;
+#else
+		int fileDescriptor;
+#endif
+
+		// release the mapping and the file
+		void unmap();
+
+	public:
+		// Default contructor: map the file
+		// @exception runtime_error if the file cannot be opened or is not a valid binary result file
+		explicit MappedResult(const std::string& fileName);
+		MappedResult(const MappedResult&) = delete; // the mapping is owned by a single object
+		MappedResult& operator=(const MappedResult&) = delete;
+
+		// unmap the file
+		~MappedResult();
+
+		// Get methods
+		int getNodes() const;
+		int getRecords() const;
+		double getDeltax() const;
+		double getDeltat() const;
+		bool isSinglePrecision() const;
+		double getTime(int record) const;
+		double getValue(int record, int node) const;
+
+		// Methods
+		// temperature at the nodes [firstNode, lastNode) of one record
+		Vector readRecord(int record, int firstNode, int lastNode) const;
+
+		// time history of one node over the records [firstRecord, lastRecord)
+		Vector readNode(int node, int firstRecord, int lastRecord) const;
+};
+
+// true if the machine stores numbers little-endian (the byte order of the files)
+bool isLittleEndian();
+#endif
@@ -0,0 +1,137 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "exact.h"
+#include "profiler.h"
+#include <cmath>
+#include <exception>
+#include <thread>
+using namespace std;
+
+
+// Default constructor
+ExactSolution::ExactSolution(double Diff, double L, double T_surf, double T_init) {
+	D_value = Diff;
+	thickness = L;
+	t_surf = T_surf;
+	t_init = T_init;
+	tolerance = 1e-10;
+	maxModes = 1000;
+	threads = 0;
+	symmetric = false;
+}
+
+// Get & Set methods
+void ExactSolution::setTolerance(double tol) {
+	tolerance = tol;
+}
+
+void ExactSolution::setMaxModes(int modes) {
+	maxModes = modes;
+}
+
+void ExactSolution::setThreads(int threadCount) {
+	threads = threadCount;
+}
+
+void ExactSolution::setSymmetric(bool on) {
+	symmetric = on;
+}
+
+int ExactSolution::getModeCount() const {
+	return coefficients.getSize();
+}
+
+// Methods
+void ExactSolution::setTime(double t) {
+	PROFILE_SCOPE(PhaseExactSolution);
+	double amplitude = fabs(2 * (t_init - t_surf));
+	double k = D_value * (pi / thickness) * (pi / thickness) * t;
+	coefficients.clear();
+	for (int m = 1; coefficients.getSize() < maxModes; m += 2) {
+		double c = exp(-k * m * m) * 2 / (m * pi);
+		coefficients.push_back(2 * (t_init - t_surf) * c);
+
+		// the terms decrease faster than a geometric series of ratio next / c, which bounds the rest of the series
+		double next = exp(-k * (m + 2) * (m + 2)) * 2 / ((m + 2) * pi);
+		double ratio = next / c;
+		if (ratio < 1 && amplitude * next / (1 - ratio) < tolerance)
+			break;
+	}
+}
+
+double ExactSolution::evaluate(double x) const {
+	double q = pi * x / thickness;
+	double twoCos = 2 * cos(2 * q);
+	double s = sin(q); // sin(m q)
+	double sPrevious = -s; // sin((m - 2) q)
+	double sum = 0.0;
+	for (int j = 0; j < coefficients.getSize(); j++) {
+		sum += coefficients[j] * s;
+		double sNext = twoCos * s - sPrevious;
+		sPrevious = s;
+		s = sNext;
+	}
+	return t_surf + sum;
+}
+
+void ExactSolution::evaluateNodes(Vector& v, double dx, int first, int last) const {
+	for (int i = first; i < last; i++) {
+		v[i] = evaluate(i * dx);
+	}
+}
+
+Vector ExactSolution::evaluate(int nodes, double dx) const {
+	PROFILE_SCOPE(PhaseExactSolution);
+	Vector v(nodes);
+	int computed = nodes; // nodes evaluated, the others are mirrored
+	if (symmetric && nodes > 2 && fabs((nodes - 1) * dx - thickness) <= 1e-9 * thickness)
+		computed = (nodes - 1) / 2 + 1; // up to the centreline
+	int n = threads;
+	if (n <= 0)
+		n = int(thread::hardware_concurrency());
+	if (n > 1 && double(computed) * getModeCount() > 1e6) { // share large grids between threads, each one evaluating a contiguous block of nodes
+		vector<thread> workers;
+		vector<exception_ptr> failures(n); // an exception of a thread is rethrown here, once every thread is joined
+		for (int k = 0; k < n; k++) {
+			int first = int((long long)(computed) * k / n);
+			int last = int((long long)(computed) * (k + 1) / n);
+			workers.push_back(thread([this, &v, &failures, dx, first, last, k] {
+				try {
+					evaluateNodes(v, dx, first, last);
+				}
+				catch (...) {
+					failures[k] = current_exception();
+				}
+			}));
+		}
+		for (int k = 0; k < n; k++) {
+			workers[k].join();
+		}
+		for (int k = 0; k < n; k++) {
+			if (failures[k])
+				rethrow_exception(failures[k]);
+		}
+	}
+	else
+		evaluateNodes(v, dx, 0, computed);
+	for (int i = computed; i < nodes; i++) {
+		v[i] = v[nodes - 1 - i];
+	}
+	return v;
+}
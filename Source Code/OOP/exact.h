@@ -0,0 +1,69 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef EXACT_H
+#define EXACT_H
+#include "vector.h"
+
+
+const double pi = 3.14159265358979323846; // full double precision
+
+
+// Exact (analytic) solution of the problem, as a sine series:
+// T(x,t) = t_surf + 2 (t_init - t_surf) sum_{m odd} exp(-D (m pi / L)^2 t) 2 / (m pi) sin(m pi x / L)
+// (the even modes are all zero since 1 - (-1)^m = 0).
+// The coefficients of the modes depend only on t: they are computed once by setTime, and the series is truncated
+// as soon as the remaining terms are below the tolerance. The sines of all the modes at a node are then obtained by
+// the recurrence sin((m + 2) q) = 2 cos(2 q) sin(m q) - sin((m - 2) q), so evaluating a node only costs one sin and one cos.
+class ExactSolution {
+	// Attributes
+	private:
+		double D_value, thickness, t_surf, t_init; // respectively: diffusion coefficient, thickness of the wall, temperature of the sides, initial temperature
+		double tolerance; // truncation error allowed on the temperature (K)
+		int maxModes; // maximum number of odd modes kept, the series converges slowly near t = 0
+		int threads; // threads used to evaluate large grids, one per hardware thread if <= 0
+		bool symmetric; // the grids spanning the whole wall are evaluated up to the centreline, then mirrored
+		Vector coefficients; // coefficient of the odd modes 1, 3, 5, ... at the time set, including the amplitude 2 (t_init - t_surf)
+
+		// evaluate the nodes [first, last) of a grid of space step dx
+		void evaluateNodes(Vector& v, double dx, int first, int last) const;
+
+	public:
+		// Default contructor
+		ExactSolution(double Diff, double L, double T_surf, double T_init);
+
+		// Get & Set methods
+		void setTolerance(double tol);
+		void setMaxModes(int modes);
+		void setThreads(int threadCount);
+		// symmetric mode (default off): the solution is symmetric about the centre of the wall, so on a grid whose last node is the right side
+		// (thickness a multiple of dx) only the nodes up to the centreline are evaluated, the others taking the value of their mirror image
+		void setSymmetric(bool on);
+		int getModeCount() const; // number of odd modes kept at the time set
+
+		// Methods
+		// compute the coefficients of the modes at the time t and truncate the series
+		void setTime(double t);
+
+		// temperature at a single position x, at the time set
+		double evaluate(double x) const;
+
+		// temperature at the nodes 0, dx, 2 dx, ... (nodes nodes) at the time set
+		Vector evaluate(int nodes, double dx) const;
+};
+#endif
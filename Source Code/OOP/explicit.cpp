@@ -1,194 +1,488 @@
-/***********************************************************************\
-#                                                                       #
-#                C R A N F I E L D   U N I V E R S I T Y                #
-#                          2 0 1 9  /  2 0 2 0                          #
-#                                                                       #
-#               MSc in Aerospace Computational Engineering              #
-#                                                                       #
-#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
-#                                                                       #
-#-----------------------------------------------------------------------#
-#                                                                       #
-#   Main Contributors:                                                  #
-#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
-#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
-#                                                                       #
-\***********************************************************************/
-
-
-#include "explicit.h"
-#include "implicit.h" // We use an Implicit object
-#include <cmath>
-
-
-// Default constructor
-Explicit::Explicit() { // Will be initialised by the Analysis class
-	deltat = 0;
-	deltax = 0;
-	D_value = 0;
-	spaceDomain = 0;
-	timeDomain = 0;
-	t_surf = 0;
-	t_init = 0;
-}
-
-// Get & set methods
-void Explicit::setDeltat(double t) {
-	deltat = t;
-}
-                                                                                           
-void Explicit::setDeltax(double x) {
-	deltax = x;
-}
-
-void Explicit::setD_value(double D) {
-	D_value = D;
-}
-
-void Explicit::setSpaceDomain(int space) {
-	spaceDomain = space;
-}
-
-void Explicit::setTimeDomain(int time) {
-	timeDomain = time;
-}
-
-void Explicit::setT_surf(double Tsurf) {
-	t_surf = Tsurf;
-}
-
-void Explicit::setT_init(double Tinit) {
-	t_init = Tinit;
-}
-
-// Other methods
-Vector Explicit::duFortSolve(int DufortFirstStepMethod) {
-	double a = 2 * D_value * deltat / (deltax * deltax);
-	int choice = DufortFirstStepMethod;
-	Vector v1, v2, v3; // v1 == n - 1 // v2 == n // v3 == n + 1	
-
-	switch (choice)
-	{
-		case 1: { // First Option: Use the FTCS scheme to get the solution at the first time step.
-			// fill out the first vector i.e. initial temperature distribution along the space domain
-			v1.push_back(t_surf); // node #0 (first node)
-			for (int i = 1; i < spaceDomain; i++) { // nodes ranging from #1 to #619 (intermediate nodes)
-				v1.push_back(t_init);
-			}
-			v1.push_back(t_surf); // node #620 (last node)
-
-			// fill out the solution at the first time step
-			v2.push_back(t_surf);
-			for (int i = 1; i < spaceDomain; i++) {
-				v2.push_back((a / 2) * v1[i - 1] + (1 - a) * v1[i] + (a / 2) * v1[i + 1]); // FTCS(forward in time, Central in space)
-			}
-			v2.push_back(t_surf);
-			break;
-		}
-		case 2: { // Second Option: At t=0 every space node at 38C, and set the sides at 149C
-			v1.push_back(t_init);
-			for (int i = 1; i < spaceDomain; i++) {
-				v1.push_back(t_init);
-			}
-			v1.push_back(t_init);
-
-			v2.push_back(t_surf);
-			for (int i = 1; i < spaceDomain; i++) {
-				v2.push_back(t_init);
-			}
-			v2.push_back(t_surf);
-			break;
-		}
-		case 3:	{ // Third Option: Use the laasonen simple implicit scheme for the first time step
-			v1.push_back(t_surf);
-			for (int i = 1; i < spaceDomain; i++) {
-				v1.push_back(t_init);
-			}
-			v1.push_back(t_surf);
-
-			// create an object Implicit
-			Implicit laassonen;
-			laassonen.setDeltat(deltat);
-			laassonen.setDeltax(deltax);
-			laassonen.setSpaceDomain(spaceDomain);
-			laassonen.setTimeDomain(1);   // use this method only for the first time step
-			laassonen.setD_value(D_value);
-			laassonen.setT_init(t_init);
-			laassonen.setT_surf(t_surf);
-			v2 = laassonen.laasonenSolve();
-			break;
-		}
-		case 4: { // Fourth Option: use FTCS but with a time step at 0.00001, so more likely stable than the first FTCS.
-			v1.push_back(t_surf);
-			for (int i = 1; i < spaceDomain; i++) {
-				v1.push_back(t_init);
-			}
-			v1.push_back(t_surf);
-
-			Vector v4;
-			double b = 2 * D_value * 0.00001 / (deltax * deltax);
-			for (int t = 0; t < deltat/0.00001; t++) { // adapt the number of iterration to stop at the first time step of Dufort-Frankel
-				v4.push_back(t_surf);
-				for (int i = 1; i < spaceDomain; i++) {
-					v4.push_back((b / 2) * v1[i - 1] + (1 - b) * v1[i] + (b / 2) * v1[i + 1]);
-				}
-				v4.push_back(t_surf);
-			}
-			v2 = v4;
-			v4.clear();
- 			break;
-		}
-		default:
-			std::cout << "ERROR! ENTER A VALUE OF 1, 2, 3 or 4 ONLY: ";
-			break; 
-	}
-
-	// For the other time steps, use the classic DuFort-Frankel Scheme
-	for (int t = 2; t < timeDomain; t++) {
-		v3.push_back(t_surf);
-		for (int i = 1; i < spaceDomain; i++) {
-			v3.push_back(((1 - a) / (1 + a)) * v1[i] + (a / (1 + a)) * (v2[i + 1] + v2[i - 1]));
-		}
-		v3.push_back(t_surf);
-
-		// stack management before the next loop
-		v1 = v2;
-		v2 = v3;
-		v3 = {};
-	}
-	return v2; // Last Vector returned
-}
-
-Vector Explicit::richardsonSolve() {
-	double a = 2 * D_value * deltat / (deltax * deltax);
-	Vector v1, v2, v3;
-
-	// fill out the initial vector
-	v1.push_back(t_surf);
-	for (int i = 1; i < spaceDomain; i++) {
-		v1.push_back(t_init);
-	}
-	v1.push_back(t_surf);
-
-	// use the FTCS method to get the solution at the first time step
-	v2.push_back(t_surf);
-	for (int i = 1; i < spaceDomain; i++) {
-		v2.push_back((a / 2) * v1[i - 1] + (1 - a) * v1[i] + (a / 2) * v1[i + 1]);
-	}
-	v2.push_back(t_surf);
-
-	// classic Richardson scheme to find out the other time step
-	for (int t = 2; t < timeDomain; t++) {
-		v3.push_back(t_surf);
-		for (int i = 1; i < spaceDomain; i++) {
-			v3.push_back(v1[i] + a * (v2[i + 1] - 2*v2[i] + v2[i - 1]));
-		}
-		v3.push_back(t_surf);
-
-		// stack management before the next loop
-		v1 = v2;
-		v2 = v3;
-		v3 = {};
-	}
-	return v2; // Last Vector returned
-}
\ No newline at end of file
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "explicit.h"
+#include "levels.h" // rolling storage of the time levels
+#include "barrier.h" // synchronisation of the subdomains at each time step
+#include "profiler.h" // phase timers and counters
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+static const int minNodesPerThread = 2048; // below, the synchronisation of the threads costs more than the step itself
+
+// cores the calling thread may run on (affinity mask inherited from the process: taskset, cgroup cpusets), in increasing order.
+// Empty where it is not known (not Linux)
+static std::vector<int> allowedCores() {
+	std::vector<int> cores;
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+		for (int c = 0; c < CPU_SETSIZE; c++) {
+			if (CPU_ISSET(c, &set))
+				cores.push_back(c);
+		}
+	}
+#endif
+	return cores;
+}
+
+// pin the calling thread to the core "core" (Linux only, elsewhere the scheduler keeps its choice)
+static void pinToCore(int core) {
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+
+// Default constructor
+Explicit::Explicit() { // Will be initialised by the Analysis class
+	deltat = 0;
+	deltax = 0;
+	D_value = 0;
+	spaceDomain = 0;
+	timeDomain = 0;
+	t_surf = 0;
+	t_init = 0;
+	tileSteps = 32; // 3 levels of 8192 + 2 * 32 nodes: about 200 kB of cache
+	tileNodes = 8192;
+	threads = 1;
+	steadyTolerance = 0;
+	stoppedStep = -1;
+	precision = 1;
+	starterFraction = 0.5;
+	symmetric = false;
+}
+
+// Get & set methods
+void Explicit::setDeltat(double t) {
+	deltat = t;
+}
+                                                                                           
+void Explicit::setDeltax(double x) {
+	deltax = x;
+}
+
+void Explicit::setD_value(double D) {
+	D_value = D;
+}
+
+void Explicit::setSpaceDomain(int space) {
+	spaceDomain = space;
+}
+
+void Explicit::setTimeDomain(int time) {
+	timeDomain = time;
+}
+
+void Explicit::setT_surf(double Tsurf) {
+	t_surf = Tsurf;
+}
+
+void Explicit::setT_init(double Tinit) {
+	t_init = Tinit;
+}
+
+void Explicit::setTemporalBlocking(int steps, int nodes) {
+	tileSteps = steps;
+	tileNodes = nodes;
+}
+
+void Explicit::setThreads(int count) {
+	threads = count;
+}
+
+void Explicit::setSteadyTolerance(double tol) {
+	steadyTolerance = tol;
+}
+
+int Explicit::getStoppedStep() const {
+	return stoppedStep;
+}
+
+void Explicit::setPrecision(int choice) {
+	precision = choice;
+}
+
+void Explicit::setStarterSubstep(double fraction) {
+	starterFraction = (fraction > 0 && fraction <= 1) ? fraction : 0.5;
+}
+
+void Explicit::setSymmetric(bool on) {
+	symmetric = on;
+}
+
+void Explicit::addObserver(StepObserver* observer) {
+	observers.push_back(observer);
+}
+
+void Explicit::clearObservers() {
+	observers.clear();
+}
+
+void Explicit::notifyObservers(int step, const Vector& level) {
+	for (int k = 0; k < int(observers.size()); k++) {
+		observers[k]->observe(step, step * deltat, level);
+	}
+}
+
+void Explicit::finishSteady(int step, const Vector& level) {
+	stoppedStep = step;
+	for (int t = step + 1; t < timeDomain; t++) {
+		notifyObservers(t, level);
+	}
+}
+
+ExplicitProblem Explicit::problem(int lastNode) const {
+	ExplicitProblem p;
+	p.spaceDomain = lastNode;
+	p.wallDomain = spaceDomain;
+	p.deltat = deltat;
+	p.deltax = deltax;
+	p.D_value = D_value;
+	p.t_surf = t_surf;
+	p.t_init = t_init;
+	p.starterFraction = starterFraction;
+	return p;
+}
+
+// Other methods
+Vector Explicit::duFortSolve(int DufortFirstStepMethod) {
+	PROFILE_KERNEL("dufort", DuFortFrankel::flopsPerNode, 3 * valueBytes()); // read n - 1 and n, write n + 1
+	// one compiled solver per start method, picked once instead of a switch
+	typedef Vector (Explicit::*Solver)();
+	static const Solver solvers[5] = {
+		&Explicit::solveWall<DuFortFrankel, InvalidStart>,
+		&Explicit::solveWall<DuFortFrankel, FTCSStart>, // First Option: Use the FTCS scheme to get the solution at the first time step.
+		&Explicit::solveWall<DuFortFrankel, ConstantStart>, // Second Option: At t=0 every space node at 38C, and set the sides at 149C
+		&Explicit::solveWall<DuFortFrankel, LaasonenStart>, // Third Option: Use the laasonen simple implicit scheme for the first time step
+		&Explicit::solveWall<DuFortFrankel, SubstepFTCSStart> // Fourth Option: use FTCS with sub-steps within its stability limit
+	};
+	int choice = (DufortFirstStepMethod >= 1 && DufortFirstStepMethod <= 4) ? DufortFirstStepMethod : 0;
+	Vector solution = (this->*solvers[choice])();
+	countMarch();
+	return solution;
+}
+
+Vector Explicit::richardsonSolve() {
+	PROFILE_KERNEL("richardson", Richardson::flopsPerNode, 3 * valueBytes());
+	// use the FTCS method to get the solution at the first time step, then the classic Richardson scheme
+	Vector solution = solveWall<Richardson, FTCSStart>();
+	countMarch();
+	return solution;
+}
+
+double Explicit::valueBytes() const {
+	return (precision == 2 || precision == 3) ? sizeof(float) : sizeof(double);
+}
+
+void Explicit::countMarch() const {
+	long long steps = (stoppedStep >= 0) ? stoppedStep : std::max(timeDomain - 1, 0);
+	PROFILE_COUNT(CounterStepsTaken, steps);
+	PROFILE_COUNT(CounterNodesUpdated, steps * (spaceDomain - 1));
+	PROFILE_COUNT(CounterStepsSkipped, std::max(timeDomain - 1, 0) - steps);
+}
+
+int Explicit::marchThreads() const {
+	int count = (threads > 0) ? threads : int(std::thread::hardware_concurrency());
+	return std::min(count, (spaceDomain - 1) / minNodesPerThread);
+}
+
+bool Explicit::halfDomain() const {
+	if (!symmetric || !observers.empty() || spaceDomain < 4)
+		return false;
+	if (precision == 2 || precision == 3) // always level by level
+		return true;
+	return marchThreads() <= 1 && !(tileSteps > 1 && spaceDomain + 1 >= 2 * tileNodes);
+}
+
+template<class Scheme, class Start>
+Vector Explicit::solveWall() {
+	if (!halfDomain())
+		return solveWith<Scheme, Start, FixedSurfaces>();
+	Vector half = (spaceDomain % 2 == 0) ? solveWith<Scheme, Start, MirrorOnNode>() : solveWith<Scheme, Start, MirrorBetweenNodes>();
+	return unfoldHalf(half, spaceDomain);
+}
+
+template<class Scheme, class Start, class Boundary>
+Vector Explicit::solveWith() {
+	PROFILE_TIMER(setup, PhaseSetup, 1);
+	PROFILE_START(setup);
+	stoppedStep = -1;
+	double a = 2 * D_value * deltat / (deltax * deltax);
+	int N = Boundary::lastNode(spaceDomain);
+	TimeLevels levels; // n - 1, n and n + 1 allocated once for the whole time march
+	levels.resize(N + 1);
+	Start::template start<Boundary>(problem(N), levels.previous(), levels.present());
+	PROFILE_STOP(setup);
+	PROFILE_SCOPE(PhaseTimeLoop);
+	notifyObservers(0, levels.previous());
+	notifyObservers(1, levels.present());
+	if (timeDomain <= 2)
+		return std::move(levels.present());
+
+	// reduced precision: float levels, the arithmetic in float or in double
+	if (precision == 2)
+		return marchReduced<Scheme, Boundary, float, float>(a, levels.previous(), levels.present());
+	if (precision == 3)
+		return marchReduced<Scheme, Boundary, float, double>(a, levels.previous(), levels.present());
+
+	// several cores: the grid is shared between the threads
+	int count = marchThreads();
+	if (!Boundary::mirrored && count > 1) {
+		int done = advanceParallel(levelKernel<Scheme>, a, levels, timeDomain - 2, count, 1);
+		if (done < timeDomain - 2)
+			finishSteady(1 + done, levels.present());
+		return std::move(levels.present());
+	}
+
+	// large grid and nobody looking at the intermediate levels: the time march is done tile by tile in cache
+	if (!Boundary::mirrored && observers.empty() && tileSteps > 1 && spaceDomain + 1 >= 2 * tileNodes) {
+		int done = advanceTiled(levelKernel<Scheme>, a, levels, timeDomain - 2);
+		if (done < timeDomain - 2)
+			finishSteady(1 + done, levels.present());
+		return std::move(levels.present());
+	}
+
+	// For the other time steps, use the scheme level by level, the new level is written in place in the storage of the oldest one
+	for (int t = 2; t < timeDomain; t++) {
+		Vector& v1 = levels.previous();
+		Vector& v2 = levels.present();
+		Vector& v3 = levels.next();
+		Boundary::apply(&v3[0], N, t_surf);
+		levelKernel<Scheme>(a, &v1[0], &v2[0], &v3[0], Boundary::first(), Boundary::end(N));
+		Boundary::close(&v3[0], N);
+		notifyObservers(t, v3);
+
+		// stack management before the next loop: no copy, the levels are only renamed
+		levels.rotate();
+		if (steadyTolerance > 0 && maxChange(levels.present(), levels.previous()) < steadyTolerance) {
+			finishSteady(t, levels.present());
+			break;
+		}
+	}
+	return std::move(levels.present()); // Last Vector returned, its storage is handed over without copy
+}
+
+template<class Scheme, class Boundary, class Storage, class Compute>
+Vector Explicit::marchReduced(double a, const Vector& older, const Vector& present) {
+	int N = present.getSize() - 1; // last node stored
+	AlignedVector<Storage> store[3]; // levels n - 1, n and n + 1, the level of the time step t is in store[t % 3]
+	store[0].assign(older.begin(), older.end());
+	store[1].assign(present.begin(), present.end());
+	store[2].resize(N + 1);
+	Vector level = present, last; // newest level in double for the observers and the steady state check, and the one before
+	bool convert = !observers.empty() || steadyTolerance > 0;
+
+	for (int t = 2; t < timeDomain; t++) {
+		Storage* next = &store[t % 3][0];
+		Boundary::apply(next, N, t_surf);
+		levelKernel<Scheme, Storage, Compute>(a, &store[(t - 2) % 3][0], &store[(t - 1) % 3][0], next, Boundary::first(), Boundary::end(N));
+		Boundary::close(next, N);
+		if (!convert)
+			continue;
+		std::swap(level, last);
+		level.assign(next, next + N + 1);
+		notifyObservers(t, level);
+		if (steadyTolerance > 0 && maxChange(level, last) < steadyTolerance) {
+			finishSteady(t, level);
+			return level;
+		}
+	}
+	const AlignedVector<Storage>& result = store[(timeDomain - 1) % 3];
+	level.assign(result.begin(), result.end());
+	return level;
+}
+
+int Explicit::advanceTiled(LevelKernel kernel, double a, TimeLevels& levels, int steps) {
+	int N = spaceDomain;
+	int halo = tileSteps; // a tile loses one valid node on each side per step: it is loaded with tileSteps extra nodes on each side
+	Vector& older = levels.previous();
+	Vector& present = levels.present();
+	Vector& nextOlder = levels.next(); // the tiles write in (nextOlder, nextPresent), the halos of their neighbours are still read from (older, present)
+	Vector nextPresent(N + 1);
+	TimeLevels local; // levels of one tile, in cache
+	local.resize(std::min(N + 1, tileNodes + 2 * halo));
+
+	for (int done = 0; done < steps; done += tileSteps) {
+		int blockSteps = std::min(tileSteps, steps - done);
+		for (int lo = 0; lo <= N; lo += tileNodes) {
+			int hi = std::min(N + 1, lo + tileNodes); // nodes [lo, hi) written by this tile
+			int wl = std::max(0, lo - blockSteps), wh = std::min(N, hi - 1 + blockSteps); // window [wl, wh] loaded
+			int width = wh - wl + 1;
+			for (int i = 0; i < width; i++) {
+				local.previous()[i] = older[wl + i];
+				local.present()[i] = present[wl + i];
+			}
+			for (int s = 1; s <= blockSteps; s++) {
+				// valid part of the new level: shrinks by one node per step on the sides inside the grid, the walls are kept at t_surf
+				int from = (wl == 0) ? 1 : wl + s;
+				int to = (wh == N) ? N : wh - s + 1;
+				double* next = &local.next()[0];
+				if (wl == 0)
+					next[0] = t_surf;
+				if (wh == N)
+					next[N - wl] = t_surf;
+				kernel(a, &local.previous()[0], &local.present()[0], next, from - wl, to - wl);
+				local.rotate();
+			}
+			for (int i = lo; i < hi; i++) {
+				nextOlder[i] = local.previous()[i - wl];
+				nextPresent[i] = local.present()[i - wl];
+			}
+		}
+		std::swap(older, nextOlder);
+		std::swap(present, nextPresent);
+		if (steadyTolerance > 0 && maxChange(present, older) < steadyTolerance)
+			return done + blockSteps;
+	}
+	return steps;
+}
+
+int Explicit::advanceParallel(LevelKernel kernel, double a, TimeLevels& levels, int steps, int count, int firstStep) {
+	int N = spaceDomain;
+	std::vector<int> first(count + 1); // the interior nodes [1, N) are split: the subdomain p owns [first[p], first[p + 1])
+	for (int p = 0; p <= count; p++) {
+		first[p] = 1 + int((long long)(N - 1) * p / count);
+	}
+	// private levels of each subdomain: owned nodes at [1, n], halos at 0 and n + 1 (the walls for the first and last subdomains).
+	// The level t is kept in local[p][t % 3], so that a neighbour reads the halos without looking at the rotation of the other threads
+	std::vector<std::vector<Vector>> local(count, std::vector<Vector>(3));
+	Vector gathered;
+	if (!observers.empty())
+		gathered = levels.present();
+	SpinBarrier barrier(count);
+	// one allowed core per thread; with fewer allowed cores than threads (or an unknown mask) the scheduler places them
+	std::vector<int> cores = allowedCores();
+	bool pin = (int(cores.size()) >= count);
+	std::vector<double> changes(2 * count); // largest change of each subdomain at the steps of parity 0 and 1 (a slot is rewritten two barriers after it is read)
+	int reached = firstStep + steps; // last level computed
+	// exception of each thread (MemoryLimitExceeded from its private levels, or from the observers on the thread 0), rethrown by the caller:
+	// a thread that fails still meets the others at the barriers, and all of them stop at the same point
+	std::vector<std::exception_ptr> failures(count);
+
+	auto work = [&](int p) {
+		if (pin)
+			pinToCore(cores[p]);
+		int lo = first[p], n = first[p + 1] - first[p];
+		try {
+			for (int k = 0; k < 3; k++) { // first touch by the thread using the memory
+				local[p][k].refill(n + 2, t_surf);
+			}
+		}
+		catch (...) {
+			failures[p] = std::current_exception();
+			barrier.wait();
+			return;
+		}
+		// the walls (halo 0 of the first subdomain, halo n + 1 of the last one) stay at t_surf in every level, as the serial march sets them:
+		// the older level of ConstantStart has them at t_init
+		for (int j = (p == 0) ? 1 : 0; j <= ((p == count - 1) ? n : n + 1); j++) {
+			local[p][(firstStep + 2) % 3][j] = levels.previous()[lo - 1 + j];
+			local[p][firstStep % 3][j] = levels.present()[lo - 1 + j];
+		}
+		barrier.wait();
+		for (int q = 0; q < count; q++) {
+			if (failures[q])
+				return;
+		}
+
+		int last = firstStep + steps;
+		for (int t = firstStep; t < firstStep + steps; t++) {
+			Vector& older = local[p][(t + 2) % 3];
+			Vector& present = local[p][t % 3];
+			Vector& next = local[p][(t + 1) % 3];
+			kernel(a, &older[0], &present[0], &next[0], 1, n + 1);
+			if (steadyTolerance > 0) { // owned nodes only: the halos of next are not exchanged yet
+				double change = 0;
+				for (int j = 1; j <= n; j++) {
+					change = std::max(change, std::fabs(next[j] - present[j]));
+				}
+				changes[(t % 2) * count + p] = change;
+			}
+			barrier.wait();
+
+			// every thread takes the same decision from the same slots
+			bool steady = (steadyTolerance > 0);
+			for (int q = 0; q < count && steady; q++) {
+				steady = (changes[(t % 2) * count + q] < steadyTolerance);
+			}
+
+			// halo exchange: the edges of the neighbours at the level t + 1 (they are only rewritten at the level t + 4)
+			if (p > 0) {
+				const Vector& left = local[p - 1][(t + 1) % 3];
+				next[0] = left[left.size() - 2];
+			}
+			if (p < count - 1)
+				next[n + 1] = local[p + 1][(t + 1) % 3][1];
+
+			if (!observers.empty()) { // the level is gathered in one Vector for the observers, notified by the thread 0
+				for (int j = 1; j <= n; j++) {
+					gathered[lo - 1 + j] = next[j];
+				}
+				barrier.wait();
+				if (p == 0) {
+					try {
+						notifyObservers(t + 1, gathered);
+					}
+					catch (...) {
+						failures[0] = std::current_exception();
+					}
+				}
+				barrier.wait();
+				if (failures[0])
+					return;
+			}
+			if (steady) {
+				last = t + 1;
+				break;
+			}
+		}
+		if (p == 0)
+			reached = last;
+
+		// the two last levels are copied back in the storage of the caller
+		for (int j = 1; j <= n; j++) {
+			levels.previous()[lo - 1 + j] = local[p][(last + 2) % 3][j];
+			levels.present()[lo - 1 + j] = local[p][last % 3][j];
+		}
+	};
+
+	std::vector<std::thread> workers; // the calling thread only waits, so that its own affinity is left untouched
+	for (int p = 0; p < count; p++) {
+		workers.push_back(std::thread(work, p));
+	}
+	for (int p = 0; p < int(workers.size()); p++) {
+		workers[p].join();
+	}
+	for (int p = 0; p < count; p++) {
+		if (failures[p])
+			std::rethrow_exception(failures[p]);
+	}
+	return reached - firstStep;
+}
@@ -1,47 +1,137 @@
-/***********************************************************************\
-#                                                                       #
-#                C R A N F I E L D   U N I V E R S I T Y                #
-#                          2 0 1 9  /  2 0 2 0                          #
-#                                                                       #
-#               MSc in Aerospace Computational Engineering              #
-#                                                                       #
-#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
-#                                                                       #
-#-----------------------------------------------------------------------#
-#                                                                       #
-#   Main Contributors:                                                  #
-#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
-#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
-#                                                                       #
-\***********************************************************************/
-
-
-#ifndef EXPLICIT_H
-#define EXPLICIT_H
-#include "vector.h" // We use vector objects as a data storage  
-
-
-class Explicit {
-	// Atributes
-	private: 
-		int spaceDomain, timeDomain; // number of nodes for the space and time grids
-		double deltat, deltax, D_value, t_surf, t_init;  // respectively: time step, space step, diffusion coefficient, temperature of the sides, initial temperature.
-
-	public:
-		// Default contructor
-		Explicit();
-		
-		// Get & Set methods
-		void setDeltat(double t);
-		void setDeltax(double x);
-		void setD_value(double D);
-		void setSpaceDomain(int space);
-		void setTimeDomain(int time);
-		void setT_surf(double Tsurf);
-		void setT_init(double Tinit);
-		
-		// other Methods
-		Vector duFortSolve(int DufortFirstStepMethod); // duFortSolve use the duFort Frankel scheme to solve the heat equation, the integer in parameter indicates which approximation will be carry out for the solution at the first time step
-		Vector richardsonSolve(); // Same that duFortSolve method, but with the richarson method.
-};
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef EXPLICIT_H
+#define EXPLICIT_H
+#include "vector.h" // We use vector objects as a data storage  
+#include "observer.h" // objects notified at each time step
+#include "schemes.h" // policies of the solver core
+class TimeLevels;
+
+
+class Explicit {
+	// Atributes
+	private: 
+		int spaceDomain, timeDomain; // number of nodes for the space and time grids
+		double deltat, deltax, D_value, t_surf, t_init;  // respectively: time step, space step, diffusion coefficient, temperature of the sides, initial temperature.
+		std::vector<StepObserver*> observers; // notified with the solution at each time level (probes, recorders...)
+		int tileSteps, tileNodes; // temporal blocking: time steps advanced per tile, nodes per tile
+		int threads; // threads sharing the grid (1: serial march)
+		double steadyTolerance; // the march stops once the largest change of a step is below it (K), 0: never
+		int stoppedStep; // time step at which the last march stopped on the steady state, -1 if it went to the end
+		int precision; // 1: double, 2: float, 3: float storage and double arithmetic
+		double starterFraction; // length of the sub-steps of the start method 4, as a fraction of the FTCS stability limit
+		bool symmetric; // march only the half of the wall up to the centreline when possible
+
+		// call every observer with the time level computed at the time step "step"
+		void notifyObservers(int step, const Vector& level);
+
+		// steady state reached at the time step "step": the observers get "level" for the steps left until timeDomain
+		void finishSteady(int step, const Vector& level);
+
+		// add the time steps and the nodes of the last march to the counters of the profiler
+		void countMarch() const;
+
+		// size of the values of the time march (bytes), 4 in single and mixed precision
+		double valueBytes() const;
+
+		// parameters of the problem given to the start policies, lastNode being the last node stored
+		ExplicitProblem problem(int lastNode) const;
+
+		// number of threads sharing the time march of the whole wall
+		int marchThreads() const;
+
+		// the half wall is marched instead of the whole one: symmetric mode on, nobody looking at the levels, and the whole wall would be
+		// marched level by level (the tiled and the threaded marches keep the whole wall, they are bound by the cache and the threads)
+		bool halfDomain() const;
+
+		// the Scheme started with Start on the whole wall (FixedSurfaces) or on its half (MirrorCentre), the solution being of the whole wall.
+		// duFortSolve and richardsonSolve pick the instantiation from a table
+		template<class Scheme, class Start>
+		Vector solveWall();
+
+		// solver core: the explicit Scheme started with Start, under the Boundary condition (policies of schemes.h), on the nodes 0 to
+		// Boundary::lastNode(spaceDomain)
+		template<class Scheme, class Start, class Boundary>
+		Vector solveWith();
+
+		// time march of solveWith in reduced precision from the start levels (older, present): the levels are stored as Storage and each node
+		// is computed in Compute. A plain level by level sweep, the observers and the steady state check get the levels converted to double
+		template<class Scheme, class Boundary, class Storage, class Compute>
+		Vector marchReduced(double a, const Vector& older, const Vector& present);
+
+		// advance the levels (previous, present) by "steps" time steps of the scheme whose kernel is given, tile by tile,
+		// each tile being carried "tileSteps" steps at a time in cache. The two last levels end in (previous, present), bit-identical to a level by level sweep.
+		// Returns the number of steps done: fewer than "steps" if the steady state is reached (checked after every tileSteps steps)
+		int advanceTiled(LevelKernel kernel, double a, TimeLevels& levels, int steps);
+
+		// same as advanceTiled, the grid being split into "count" subdomains, each advanced by its own thread in private arrays with one-node halos
+		// exchanged at every step. The observers get the levels gathered from the subdomains, numbered from firstStep + 1.
+		// Returns the number of steps done (the steady state is checked at every step)
+		int advanceParallel(LevelKernel kernel, double a, TimeLevels& levels, int steps, int count, int firstStep);
+
+	public:
+		// Default contructor
+		Explicit();
+		
+		// Get & Set methods
+		void setDeltat(double t);
+		void setDeltax(double x);
+		void setD_value(double D);
+		void setSpaceDomain(int space);
+		void setTimeDomain(int time);
+		void setT_surf(double Tsurf);
+		void setT_init(double Tinit);
+
+		// temporal blocking of the time march (default: 32 steps per tile of 8192 nodes), used on the grids of 2 tiles or more when no observer is attached.
+		// steps <= 1 sweeps the whole grid once per time step
+		void setTemporalBlocking(int steps, int nodes);
+
+		// number of threads sharing the time march (default 1, <= 0: one per hardware thread), each thread being pinned to its own core among
+		// the cores allowed to the process (no pinning if there are fewer of them than threads).
+		// The grid is split only if every thread gets at least 2048 nodes
+		void setThreads(int count);
+
+		// stop the time march once the largest change of the temperature over a time step is below tol (K), 0 (default) never stops early.
+		// The solution returned is the converged one, and the observers get it for the remaining time steps
+		void setSteadyTolerance(double tol);
+		// time step at which the last march stopped on the steady state, -1 if it went until timeDomain
+		int getStoppedStep() const;
+
+		// precision of the time march (the start method stays in double): 1 (default) double, 2 float (half the memory traffic),
+		// 3 mixed: levels stored in float, every node computed in double. Any other value is taken as 1
+		void setPrecision(int choice);
+
+		// start method 4 of DuFort-Frankel: the first time step is made of the fewest equal FTCS sub-steps no longer than "fraction"
+		// of the stability limit dx^2 / (2 D) (default 0.5, at most 1)
+		void setStarterSubstep(double fraction);
+
+		// symmetric mode (default off): the setups of this solver (the same t_surf on both sides, a uniform t_init) are symmetric about the
+		// centre of the wall, so only the half up to the centreline is marched, with a mirror (zero flux) condition there, and the whole
+		// profile is rebuilt at the end: half the work and the memory. Used when no observer is attached and the march goes level by level
+		void setSymmetric(bool on);
+
+		// the observers are not owned by the solver, they have to outlive the call to the solve methods
+		void addObserver(StepObserver* observer);
+		void clearObservers();
+		
+		// other Methods
+		Vector duFortSolve(int DufortFirstStepMethod); // duFortSolve use the duFort Frankel scheme to solve the heat equation, the integer in parameter indicates which approximation will be carry out for the solution at the first time step
+		Vector richardsonSolve(); // Same that duFortSolve method, but with the richarson method.
+};
 #endif
\ No newline at end of file
@@ -1,179 +1,674 @@
-/***********************************************************************\
-#                                                                       #
-#                C R A N F I E L D   U N I V E R S I T Y                #
-#                          2 0 1 9  /  2 0 2 0                          #
-#                                                                       #
-#               MSc in Aerospace Computational Engineering              #
-#                                                                       #
-#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
-#                                                                       #
-#-----------------------------------------------------------------------#
-#                                                                       #
-#   Main Contributors:                                                  #
-#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
-#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
-#                                                                       #
-\***********************************************************************/
-
-
-#include "implicit.h"
-#include <cmath>
-
-
-// Default constructor
-Implicit::Implicit() {
-	deltat = 0;
-	deltax = 0;
-	D_value = 0;
-	spaceDomain = 0;
-	timeDomain = 0;
-	t_surf = 0;
-	t_init = 0;
-	A = {};
-	B = {};
-	C = {};
-}
-
-// Get & set methods
-void Implicit::setDeltat(double t) {
-	deltat = t;
-}
-
-void Implicit::setDeltax(double x) {
-	deltax = x;
-}
-
-void Implicit::setD_value(double D) {
-	D_value = D;
-}
-
-void Implicit::setSpaceDomain(int space) {
-	spaceDomain = space;
-}
-
-void Implicit::setTimeDomain(int time) {
-	timeDomain = time;
-}
-
-void Implicit::setT_surf(double Tsurf) {
-	t_surf = Tsurf;
-}
-
-void Implicit::setT_init(double Tinit) {
-	t_init = Tinit;
-}
-
-Vector Implicit::thomas_algorithm(Vector d) {
-	// fill out the three diagonals
-	Vector a = A; // lower_diagonal
-	Vector b = B; //  main_diagonal
-	Vector c = C; // upper_diagonal
-
-	int n = A.size();
-
-	// row 0 divided by b
-	c[0] /= b[0];
-	d[0] /= b[0];
-	b[0] = 1;
-
-	for (int i = 1; i < n; i++) {// For all the rows left
-		// row i -= row_{i-1} * a_{i}
-		b[i] -= c[i - 1] * a[i]; 
-		d[i] -= d[i - 1] * a[i];
-		a[i] = 0; // a_{i}-1*a_{i}=0
-
-		// row_{i} divided by b_{i}
-		c[i] /= b[i];
-		d[i] /= b[i];
-		b[i] = 1; 
-	}
-	// d_{n} is stored as a solution.
-	// all the d_{i} coefficients are set thank to the simplified sysem of equations
-	for (int i = n - 2; i >= 0; i--) {
-		d[i] -= (c[i] * d[i + 1]);
-	}
-	return d;
-}
-
-Vector Implicit::laasonenSolve() {
-	Vector D;
-	double a = D_value * (deltat / (deltax * deltax));
-
-	// Fill out the three diagonals
-	// Fill out the initial vector
-	A.push_back(0); // lower_diagonal
-	B.push_back(1); //  main_diagonal
-	C.push_back(0); // upper_diagonal
-	D.push_back(t_surf); // Solution_diagonal
-	for (int i = 1; i < spaceDomain; i++) {
-		A.push_back(-a);
-		B.push_back(1 + (2 * a));
-		C.push_back(-a);
-		D.push_back(t_init);
-	}
-	A.push_back(0);
-	B.push_back(1);
-	C.push_back(0);   
-	D.push_back(t_surf);
-
-	// resset of D at each tme step
-	for (int t = 1; t < timeDomain; t++) {
-		D = thomas_algorithm(D);
-	}
-
-	// clear the diagonal in case of an other call of this method without initialisation
-	A.clear();
-	B.clear();
-	C.clear();
-	return D;
-}
-
-Vector Implicit::crankNicolsonSolve() {
-	Vector D, init;
-	double a = D_value * (deltat / (deltax * deltax));
-
-	// Fill out the initial vector
-	init.push_back(t_surf);
-	for (int i = 1; i < spaceDomain; i++) {
-		init.push_back(t_init);
-	}
-	init.push_back(t_surf);
-
-	// size-2 for the diagonals
-	A.push_back(0);
-	B.push_back(a + 1);
-	C.push_back(-a*0.5);
-	for (int i = 1; i < spaceDomain-2; i++) {
-		A.push_back(-a * 0.5);
-		B.push_back(a + 1);
-		C.push_back(-a * 0.5);
-	}
-	A.push_back(-a*0.5);
-	B.push_back(1 + a);
-	C.push_back(0);
-
-	// reduce the size of the system N to N-2. Keep taking in count the boundary conditions by added to the right hand member of the system the values erased from the reduction, so -a*149 to d[1] and -c*149 to d[N-2]
-	for(int t = 1; t < timeDomain; t++) {
-		for (int i = 0; i < spaceDomain-1; i++) {
-			if (i == 0)
-				D.push_back((a / 2) * init[i] + (1 - a) * init[i + 1] + (a / 2) * init[i + 2] + (a / 2) * t_surf); 
-			else if (i == spaceDomain - 2)
-				D.push_back((a / 2) * init[i] + (1 - a) * init[i + 1] + (a / 2) * init[i + 2] + (a / 2) * t_surf);
-			else 
-				D.push_back((a / 2) * init[i] + (1 - a) * init[i + 1] + (a / 2) * init[i + 2]);
-		}
-
-		D = thomas_algorithm(D);
-
-		// reset init by filling it with D (smaller size) and keep the boundarie conditions (init[0])
-		for (int i = 0; i < D.size();i++) {
-			init[i + 1] = D[i];
-		}
-		D.clear();
-	}
-	// clear the diagonal in case of an other call of this method without initialisation
-	A.clear();
-	B.clear();
-	C.clear();
-	return init;
-}
\ No newline at end of file
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "implicit.h"
+#include "levels.h" // maxChange
+#include "profiler.h" // phase timers and counters
+#include <algorithm>
+#include <cmath>
+
+
+// Default constructor
+Implicit::Implicit() {
+	deltat = 0;
+	deltax = 0;
+	D_value = 0;
+	spaceDomain = 0;
+	timeDomain = 0;
+	t_surf = 0;
+	t_init = 0;
+	usePartitioned = false;
+	threads = 1;
+	parallelThreshold = 100000;
+	tolerance = 0;
+	acceptedSteps = 0;
+	rejectedSteps = 0;
+	steadyTolerance = 0;
+	stoppedStep = -1;
+	precision = 1;
+	symmetric = false;
+	A = {};
+	B = {};
+	C = {};
+}
+
+// Get & set methods
+void Implicit::setDeltat(double t) {
+	deltat = t;
+}
+
+void Implicit::setDeltax(double x) {
+	deltax = x;
+}
+
+void Implicit::setD_value(double D) {
+	D_value = D;
+}
+
+void Implicit::setSpaceDomain(int space) {
+	spaceDomain = space;
+}
+
+void Implicit::setTimeDomain(int time) {
+	timeDomain = time;
+}
+
+void Implicit::setT_surf(double Tsurf) {
+	t_surf = Tsurf;
+}
+
+void Implicit::setT_init(double Tinit) {
+	t_init = Tinit;
+}
+
+void Implicit::setThreads(int count) {
+	threads = count;
+	partitioned.reset(); // a new pool of the right size is created at the next use
+}
+
+void Implicit::setParallelThreshold(int rowCount) {
+	parallelThreshold = rowCount;
+}
+
+void Implicit::setAdaptive(double tol) {
+	tolerance = tol;
+}
+
+void Implicit::setOutputTimes(const Vector& times) {
+	outputTimes = times;
+}
+
+int Implicit::getAcceptedSteps() const {
+	return acceptedSteps;
+}
+
+int Implicit::getRejectedSteps() const {
+	return rejectedSteps;
+}
+
+void Implicit::setSteadyTolerance(double tol) {
+	steadyTolerance = tol;
+}
+
+int Implicit::getStoppedStep() const {
+	return stoppedStep;
+}
+
+void Implicit::setPrecision(int choice) {
+	precision = choice;
+}
+
+void Implicit::setSymmetric(bool on) {
+	symmetric = on;
+}
+
+void Implicit::addObserver(StepObserver* observer) {
+	observers.push_back(observer);
+}
+
+void Implicit::clearObservers() {
+	observers.clear();
+}
+
+void Implicit::notifyObservers(int step, const Vector& level) {
+	notifyObservers(step, step * deltat, level);
+}
+
+void Implicit::notifyObservers(int step, double time, const Vector& level) {
+	for (int k = 0; k < int(observers.size()); k++) {
+		observers[k]->observe(step, time, level);
+	}
+}
+
+void Implicit::finishSteady(int step, const Vector& level) {
+	stoppedStep = step;
+	for (int t = step + 1; t < timeDomain; t++) {
+		notifyObservers(t, level);
+	}
+}
+
+double Implicit::valueBytes() const {
+	return (tolerance <= 0 && (precision == 2 || precision == 3)) ? sizeof(float) : sizeof(double);
+}
+
+void Implicit::countMarch() const {
+	long long steps = (tolerance > 0) ? acceptedSteps : (stoppedStep >= 0) ? stoppedStep : std::max(timeDomain - 1, 0);
+	PROFILE_COUNT(CounterStepsTaken, steps);
+	PROFILE_COUNT(CounterNodesUpdated, steps * (spaceDomain - 1));
+	if (tolerance <= 0) { // the adaptive march has no fixed number of steps
+		PROFILE_COUNT(CounterStepsSkipped, std::max(timeDomain - 1, 0) - steps);
+	}
+}
+
+void Implicit::setDiagonals(const Vector& lower, const Vector& main, const Vector& upper) {
+	A = lower;
+	B = main;
+	C = upper;
+}
+
+void Implicit::factoriseMatrix() {
+	usePartitioned = (threads != 1 && A.getSize() >= parallelThreshold);
+	if (!usePartitioned) {
+		matrix.factorise(A, B, C);
+		return;
+	}
+	if (!partitioned)
+		partitioned = std::make_shared<PartitionedTridiagonal>(threads);
+	partitioned->factorise(A, B, C);
+}
+
+void Implicit::solveMatrix(Vector& d) {
+	if (usePartitioned)
+		partitioned->solve(d);
+	else
+		matrix.solve(d);
+}
+
+Vector Implicit::thomas_algorithm(Vector d) {
+	PROFILE_COUNT(CounterNodesUpdated, d.getSize()); // the kernel scope is the loop of the caller
+	// factorise A, B, C then solve for d: to be used when the diagonals change, otherwise factorise once and solve at each time step
+	factoriseMatrix();
+	solveMatrix(d);
+	return d;
+}
+
+Vector Implicit::laasonenSolve() {
+	PROFILE_KERNEL("laasonen", 5, 7 * valueBytes()); // forward: d, a, pivot in, d out / backward: d, c' in, d out
+	stoppedStep = -1;
+	if (tolerance > 0)
+		return adaptiveSolve(1);
+	if (precision == 2 || precision == 3)
+		return reducedSolve(1);
+	if (halfDomain())
+		return halfSolve(1);
+	PROFILE_TIMER(setup, PhaseSetup, 1);
+	PROFILE_START(setup);
+	Vector D, previous;
+	double a = D_value * (deltat / (deltax * deltax));
+
+	// Fill out the three diagonals (diagonals set by setDiagonals are replaced)
+	// Fill out the initial vector
+	A.clear();
+	B.clear();
+	C.clear();
+	A.push_back(0); // lower_diagonal
+	B.push_back(1); //  main_diagonal
+	C.push_back(0); // upper_diagonal
+	D.push_back(t_surf); // Solution_diagonal
+	for (int i = 1; i < spaceDomain; i++) {
+		A.push_back(-a);
+		B.push_back(1 + (2 * a));
+		C.push_back(-a);
+		D.push_back(t_init);
+	}
+	A.push_back(0);
+	B.push_back(1);
+	C.push_back(0);   
+	D.push_back(t_surf);
+
+	// the matrix does not change in time: factorised once, then D is solved in place at each time step
+	factoriseMatrix();
+	PROFILE_STOP(setup);
+	PROFILE_TIMER(timeLoop, PhaseTimeLoop, 1);
+	PROFILE_START(timeLoop);
+	PROFILE_TIMER(solve, PhaseTridiagonalSolve, profileStride(spaceDomain));
+	notifyObservers(0, D);
+	for (int t = 1; t < timeDomain; t++) {
+		if (steadyTolerance > 0) // the solve is in place: the level n is kept to measure the change
+			previous = D;
+		PROFILE_START(solve);
+		solveMatrix(D);
+		PROFILE_STOP(solve);
+		notifyObservers(t, D);
+		if (steadyTolerance > 0 && maxChange(D, previous) < steadyTolerance) {
+			finishSteady(t, D);
+			break;
+		}
+	}
+
+	PROFILE_STOP(timeLoop);
+	countMarch();
+
+	// clear the diagonal in case of an other call of this method without initialisation
+	A.clear();
+	B.clear();
+	C.clear();
+	return D;
+}
+
+Vector Implicit::crankNicolsonSolve() {
+	PROFILE_KERNEL("crankNicolson", 10, 7 * valueBytes()); // forward: level, a, pivot in, level out / backward: level, c' in, level out
+	stoppedStep = -1;
+	if (tolerance > 0)
+		return adaptiveSolve(2);
+	if (precision == 2 || precision == 3)
+		return reducedSolve(2);
+	if (halfDomain())
+		return halfSolve(2);
+	PROFILE_TIMER(setup, PhaseSetup, 1);
+	PROFILE_START(setup);
+	Vector D, init, previous;
+	double a = D_value * (deltat / (deltax * deltax));
+
+	// Fill out the initial vector
+	init.push_back(t_surf);
+	for (int i = 1; i < spaceDomain; i++) {
+		init.push_back(t_init);
+	}
+	init.push_back(t_surf);
+
+	// size-2 for the diagonals
+	A.clear();
+	B.clear();
+	C.clear();
+	A.push_back(0);
+	B.push_back(a + 1);
+	C.push_back(-a*0.5);
+	for (int i = 1; i < spaceDomain-2; i++) {
+		A.push_back(-a * 0.5);
+		B.push_back(a + 1);
+		C.push_back(-a * 0.5);
+	}
+	A.push_back(-a*0.5);
+	B.push_back(1 + a);
+	C.push_back(0);
+
+	// the matrix does not change in time: factorised once, then each step is assembled and solved in place in init by one fused pass.
+	// The partitioned solver of the large systems needs the right hand side D, allocated once and refilled at each time step
+	factoriseMatrix();
+	if (usePartitioned)
+		D.refill(spaceDomain - 1, 0.0);
+	PROFILE_STOP(setup);
+	PROFILE_TIMER(timeLoop, PhaseTimeLoop, 1);
+	PROFILE_START(timeLoop);
+	PROFILE_TIMER(assembly, PhaseRhsAssembly, profileStride(spaceDomain));
+	PROFILE_TIMER(solve, PhaseTridiagonalSolve, profileStride(spaceDomain));
+	notifyObservers(0, init);
+
+	// reduce the size of the system N to N-2. Keep taking in count the boundary conditions by added to the right hand member of the system the values erased from the reduction, so -a*149 to d[1] and -c*149 to d[N-2]
+	for(int t = 1; t < timeDomain; t++) {
+		if (steadyTolerance > 0) // the step is in place: the level n is kept to measure the change
+			previous = init;
+		if (!usePartitioned) {
+			PROFILE_START(solve);
+			matrix.solveStencil(a / 2, 1 - a, (a / 2) * t_surf, (a / 2) * t_surf, &init[0]);
+			PROFILE_STOP(solve);
+		}
+		else {
+			PROFILE_START(assembly);
+			D[0] = (a / 2) * init[0] + (1 - a) * init[1] + (a / 2) * init[2] + (a / 2) * t_surf;
+			for (int i = 1; i < spaceDomain - 2; i++) {
+				D[i] = (a / 2) * init[i] + (1 - a) * init[i + 1] + (a / 2) * init[i + 2];
+			}
+			D[spaceDomain - 2] = (a / 2) * init[spaceDomain - 2] + (1 - a) * init[spaceDomain - 1] + (a / 2) * init[spaceDomain] + (a / 2) * t_surf;
+			PROFILE_STOP(assembly);
+
+			PROFILE_START(solve);
+			solveMatrix(D);
+			PROFILE_STOP(solve);
+			std::copy(D.begin(), D.end(), init.begin() + 1); // keep the boundarie conditions (init[0] and init[spaceDomain])
+		}
+		notifyObservers(t, init);
+		if (steadyTolerance > 0 && maxChange(init, previous) < steadyTolerance) {
+			finishSteady(t, init);
+			break;
+		}
+	}
+	PROFILE_STOP(timeLoop);
+	countMarch();
+
+	// clear the diagonal in case of an other call of this method without initialisation
+	A.clear();
+	B.clear();
+	C.clear();
+	return init;
+}
+
+template<class Matrix>
+void Implicit::factoriseStep(int scheme, double dt, Matrix& m) {
+	double a = D_value * (dt / (deltax * deltax));
+	int n = (scheme == 1) ? spaceDomain + 1 : spaceDomain - 1; // Laasonen: every node, Crank-Nicolson: the interior nodes
+	Vector lower(n), main(n), upper(n);
+	for (int i = 0; i < n; i++) {
+		if (scheme == 1) { // same matrices as laasonenSolve and crankNicolsonSolve
+			bool side = (i == 0 || i == n - 1);
+			lower[i] = side ? 0 : -a;
+			main[i] = side ? 1 : 1 + (2 * a);
+			upper[i] = side ? 0 : -a;
+		}
+		else {
+			lower[i] = (i == 0) ? 0 : -a * 0.5;
+			main[i] = a + 1;
+			upper[i] = (i == n - 1) ? 0 : -a * 0.5;
+		}
+	}
+	m.factorise(lower, main, upper);
+}
+
+void Implicit::advanceStep(int scheme, double dt, const Tridiagonal& m, Vector& level) {
+	PROFILE_SCOPE(PhaseTridiagonalSolve);
+	if (scheme == 1) {
+		m.solve(level);
+		return;
+	}
+	double a = D_value * (dt / (deltax * deltax));
+	m.solveStencil(a / 2, 1 - a, (a / 2) * t_surf, (a / 2) * t_surf, &level[0]); // right hand side of the interior nodes assembled during the solve
+}
+
+Vector Implicit::adaptiveSolve(int scheme) {
+	const int minExponent = -20, maxExponent = 30; // steps from deltat / 2^20 to deltat * 2^30
+	double end = (timeDomain - 1) * deltat;
+	double eps = 1e-9 * deltat; // two times closer than eps are the same time
+	double growth = (scheme == 1) ? 4 : 8; // the local error scales as dt^2 (Laasonen) or dt^3 (Crank-Nicolson)
+	Vector level(spaceDomain + 1), full, half;
+	level[0] = t_surf;
+	for (int i = 1; i < spaceDomain; i++) {
+		level[i] = t_init;
+	}
+	level[spaceDomain] = t_surf;
+
+	std::map<int, Tridiagonal> factorised; // matrix of the step deltat * 2^k, at k
+	Tridiagonal clippedFull, clippedHalf; // matrices of a step shortened to land on an output time
+	int k = 0;
+	int nextOutput = 0;
+	PROFILE_SCOPE(PhaseTimeLoop); // the matrices are factorised along the march, as the step sizes are reached
+	double t = 0;
+	acceptedSteps = 0;
+	rejectedSteps = 0;
+	notifyObservers(0, 0, level);
+	while (t < end - eps) {
+		// next time to land on
+		while (nextOutput < int(outputTimes.size()) && outputTimes[nextOutput] <= t + eps) {
+			nextOutput++;
+		}
+		double target = end;
+		if (nextOutput < int(outputTimes.size()) && outputTimes[nextOutput] < end)
+			target = outputTimes[nextOutput];
+
+		double dt = std::ldexp(deltat, k);
+		bool lands = (t + dt >= target - eps);
+		const Tridiagonal* fullMatrix;
+		const Tridiagonal* halfMatrix;
+		if (t + dt > target + eps) { // shortened step: its own matrices, not kept
+			dt = target - t;
+			factoriseStep(scheme, dt, clippedFull);
+			factoriseStep(scheme, dt / 2, clippedHalf);
+			fullMatrix = &clippedFull;
+			halfMatrix = &clippedHalf;
+		}
+		else {
+			for (int e = k - 1; e <= k; e++) {
+				if (factorised[e].getSize() == 0)
+					factoriseStep(scheme, std::ldexp(deltat, e), factorised[e]);
+			}
+			fullMatrix = &factorised[k];
+			halfMatrix = &factorised[k - 1];
+		}
+
+		// step doubling: the difference between one step and two half steps estimates the local error of the two half steps
+		full = level;
+		advanceStep(scheme, dt, *fullMatrix, full);
+		half = level;
+		advanceStep(scheme, dt / 2, *halfMatrix, half);
+		advanceStep(scheme, dt / 2, *halfMatrix, half);
+		double error = 0;
+		for (int i = 0; i <= spaceDomain; i++) {
+			error = std::max(error, std::fabs(half[i] - full[i]));
+		}
+		if (error > tolerance && k > minExponent) { // rejected: taken again with half the step
+			rejectedSteps++;
+			k--;
+			continue;
+		}
+
+		std::swap(level, half);
+		t = lands ? target : t + dt;
+		acceptedSteps++;
+		notifyObservers(acceptedSteps, t, level);
+		if (steadyTolerance > 0 && maxChange(level, half) * (deltat / dt) < steadyTolerance) { // converged: the remaining output times get this level
+			stoppedStep = acceptedSteps;
+			int step = acceptedSteps;
+			for (int o = nextOutput; o < int(outputTimes.size()); o++) {
+				if (outputTimes[o] > t + eps && outputTimes[o] < end)
+					notifyObservers(++step, outputTimes[o], level);
+			}
+			if (t < end - eps)
+				notifyObservers(++step, end, level);
+			break;
+		}
+		if (error * growth < 0.5 * tolerance && k < maxExponent) // the doubled step would still be well within the tolerance
+			k++;
+	}
+	countMarch();
+	return level;
+}
+
+std::vector<Vector> Implicit::laasonenSolveBatch(const Vector& Diffs, const Vector& Tsurfs, const Vector& Tinits) {
+	int K = Diffs.getSize();
+	int n = spaceDomain + 1;
+	Vector a(n * K), b(n * K), c(n * K), D(n * K); // interleaved diagonals and solutions: node i of the wall k at [i * K + k]
+
+	// same system as laasonenSolve for each wall
+	for (int k = 0; k < K; k++) {
+		double r = Diffs[k] * (deltat / (deltax * deltax));
+		b[k] = 1;
+		D[k] = Tsurfs[k];
+		for (int i = 1; i < spaceDomain; i++) {
+			a[i * K + k] = -r;
+			b[i * K + k] = 1 + (2 * r);
+			c[i * K + k] = -r;
+			D[i * K + k] = Tinits[k];
+		}
+		b[spaceDomain * K + k] = 1;
+		D[spaceDomain * K + k] = Tsurfs[k];
+	}
+
+	BatchTridiagonal batch;
+	batch.factorise(K, n, a, b, c);
+	for (int t = 1; t < timeDomain; t++) {
+		batch.solve(D);
+	}
+
+	// de-interleave the solutions
+	std::vector<Vector> walls(K, Vector(n));
+	for (int i = 0; i < n; i++) {
+		for (int k = 0; k < K; k++) {
+			walls[k][i] = D[i * K + k];
+		}
+	}
+	return walls;
+}
+
+std::vector<Vector> Implicit::crankNicolsonSolveBatch(const Vector& Diffs, const Vector& Tsurfs, const Vector& Tinits) {
+	int K = Diffs.getSize();
+	int n = spaceDomain + 1; // nodes of each wall
+	int m = spaceDomain - 1; // rows of the reduced systems (the sides are known)
+	Vector init(n * K), D(m * K), a(m * K), b(m * K), c(m * K);
+	Vector half(K), diag(K), side(K); // per wall: a/2, 1 - a and the boundary contribution (a/2) * t_surf
+
+	// same reduced system as crankNicolsonSolve for each wall
+	for (int k = 0; k < K; k++) {
+		double r = Diffs[k] * (deltat / (deltax * deltax));
+		half[k] = r / 2;
+		diag[k] = 1 - r;
+		side[k] = (r / 2) * Tsurfs[k];
+		init[k] = Tsurfs[k];
+		for (int i = 1; i < spaceDomain; i++) {
+			init[i * K + k] = Tinits[k];
+		}
+		init[spaceDomain * K + k] = Tsurfs[k];
+		for (int i = 0; i < m; i++) {
+			a[i * K + k] = (i == 0) ? 0 : -r * 0.5;
+			b[i * K + k] = r + 1;
+			c[i * K + k] = (i == m - 1) ? 0 : -r * 0.5;
+		}
+	}
+
+	BatchTridiagonal batch;
+	batch.factorise(K, m, a, b, c);
+	for (int t = 1; t < timeDomain; t++) {
+		// explicit half of the scheme, for all the walls of the row i at once
+		for (int i = 0; i < m; i++) {
+			const double* __restrict left = &init[i * K];
+			const double* __restrict centre = &init[(i + 1) * K];
+			const double* __restrict right = &init[(i + 2) * K];
+			double* __restrict d = &D[i * K];
+			for (int k = 0; k < K; k++) {
+				d[k] = half[k] * left[k] + diag[k] * centre[k] + half[k] * right[k];
+			}
+		}
+		for (int k = 0; k < K; k++) { // boundary conditions moved to the right hand side
+			D[k] += side[k];
+			D[(m - 1) * K + k] += side[k];
+		}
+
+		batch.solve(D);
+
+		for (int i = 0; i < m * K; i++) {
+			init[K + i] = D[i];
+		}
+	}
+
+	std::vector<Vector> walls(K, Vector(n));
+	for (int i = 0; i < n; i++) {
+		for (int k = 0; k < K; k++) {
+			walls[k][i] = init[i * K + k];
+		}
+	}
+	return walls;
+}
+bool Implicit::halfDomain() const {
+	bool serial = (threads == 1 || spaceDomain - 1 < parallelThreshold); // same test as factoriseMatrix
+	return symmetric && observers.empty() && serial && spaceDomain >= 4;
+}
+
+Vector Implicit::halfSolve(int scheme) {
+	PROFILE_TIMER(setup, PhaseSetup, 1);
+	PROFILE_START(setup);
+	int M = spaceDomain / 2; // last node up to the centreline, followed by a ghost node (M + 1) holding a mirror image
+	int gap = (spaceDomain % 2 == 0) ? 2 : 1; // centreline on the node M (mirror of M - 1) or between M and M + 1 (mirror of M)
+	double a = D_value * (deltat / (deltax * deltax));
+	Vector level(M + 2), previous;
+	level[0] = t_surf;
+	for (int i = 1; i <= M + 1; i++) {
+		level[i] = t_init;
+	}
+
+	// rows of the nodes 0 to M (Laasonen: the wall row is the identity) or 1 to M (Crank-Nicolson: the wall in the right hand side).
+	// The neighbour beyond the centreline is the mirror image of the node M + 1 - gap: its coefficient is added to that node in the last row
+	int n = (scheme == 1) ? M + 1 : M;
+	double off = (scheme == 1) ? -a : -a * 0.5, diagonal = (scheme == 1) ? 1 + (2 * a) : 1 + a;
+	Vector lower(n), main(n), upper(n);
+	for (int i = 0; i < n; i++) {
+		lower[i] = off;
+		main[i] = diagonal;
+		upper[i] = off;
+	}
+	if (scheme == 1) {
+		lower[0] = 0;
+		main[0] = 1;
+		upper[0] = 0;
+	}
+	else
+		lower[0] = 0;
+	upper[n - 1] = 0;
+	if (gap == 2)
+		lower[n - 1] += off;
+	else
+		main[n - 1] += off;
+	Tridiagonal m;
+	m.factorise(lower, main, upper);
+	PROFILE_STOP(setup);
+	PROFILE_SCOPE(PhaseTimeLoop);
+	PROFILE_TIMER(solve, PhaseTridiagonalSolve, profileStride(n));
+
+	for (int t = 1; t < timeDomain; t++) {
+		if (steadyTolerance > 0)
+			previous = level;
+		PROFILE_START(solve);
+		if (scheme == 1)
+			m.solve(&level[0]);
+		else // the ghost gives the right hand side of the last row its mirror image, no wall there
+			m.solveStencil(a / 2, 1 - a, (a / 2) * t_surf, 0.0, &level[0]);
+		level[M + 1] = level[M + 1 - gap];
+		PROFILE_STOP(solve);
+		if (steadyTolerance > 0 && maxChange(level, previous) < steadyTolerance) {
+			stoppedStep = t;
+			break;
+		}
+	}
+	countMarch();
+	return unfoldHalf(level, spaceDomain);
+}
+
+Vector Implicit::reducedSolve(int scheme) {
+	Vector solution = (precision == 2) ? marchReduced<float, float>(scheme) : marchReduced<float, double>(scheme);
+	countMarch();
+	return solution;
+}
+
+template<class Storage, class Compute>
+Vector Implicit::marchReduced(int scheme) {
+	PROFILE_TIMER(setup, PhaseSetup, 1);
+	PROFILE_START(setup);
+	int N = spaceDomain;
+	Compute a = Compute(D_value * (deltat / (deltax * deltax)));
+	Compute side = a / 2, centre = 1 - a, wall = side * Compute(t_surf);
+	BasicTridiagonal<Storage, Compute> m;
+	factoriseStep(scheme, deltat, m); // same matrices as laasonenSolve and crankNicolsonSolve, factorised in double
+	AlignedVector<Storage> level(N + 1);
+	level[0] = Storage(t_surf);
+	for (int i = 1; i < N; i++) {
+		level[i] = Storage(t_init);
+	}
+	level[N] = Storage(t_surf);
+	PROFILE_STOP(setup);
+	PROFILE_SCOPE(PhaseTimeLoop);
+	PROFILE_TIMER(solve, PhaseTridiagonalSolve, profileStride(N));
+	Vector out; // level in double for the observers, the steady state check and the result
+	out.assign(level.begin(), level.end());
+	notifyObservers(0, out);
+	bool convert = !observers.empty() || steadyTolerance > 0;
+
+	for (int t = 1; t < timeDomain; t++) {
+		if (scheme == 1) { // Laasonen: the level is the right hand side, the walls have identity rows
+			PROFILE_START(solve);
+			m.solve(level);
+			PROFILE_STOP(solve);
+		}
+		else { // Crank-Nicolson: the interior nodes, the walls moved to the right hand side, assembled during the solve
+			PROFILE_START(solve);
+			m.solveStencil(side, centre, wall, wall, &level[0]);
+			PROFILE_STOP(solve);
+		}
+		if (!convert)
+			continue;
+		double change = 0;
+		for (int i = 0; i <= N; i++) {
+			change = std::max(change, std::fabs(double(level[i]) - out[i]));
+			out[i] = level[i];
+		}
+		notifyObservers(t, out);
+		if (steadyTolerance > 0 && change < steadyTolerance) {
+			finishSteady(t, out);
+			return out;
+		}
+	}
+	out.assign(level.begin(), level.end());
+	return out;
+}
@@ -1,53 +1,156 @@
-/***********************************************************************\
-#                                                                       #
-#                C R A N F I E L D   U N I V E R S I T Y                #
-#                          2 0 1 9  /  2 0 2 0                          #
-#                                                                       #
-#               MSc in Aerospace Computational Engineering              #
-#                                                                       #
-#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
-#                                                                       #
-#-----------------------------------------------------------------------#
-#                                                                       #
-#   Main Contributors:                                                  #
-#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
-#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
-#                                                                       #
-\***********************************************************************/
-
-
-#ifndef IMPLICIT_H 
-#define IMPLICIT_H
-#include "vector.h"
-
-
-class Implicit {
-	// Attributes
-	private:
-		Vector A, B, C; // Triadiagonal coefficient--A: coef for T_{i-1}, B:coef for T_{i}, C: coef for T_{i+1}
-		int spaceDomain, timeDomain; // number of nodes for the space and time grids
-		double deltat, deltax, D_value, t_surf, t_init; // respectively: time step, space step, diffusion coefficient, temperature of the sides, initial temperature.
-
-	public:
-		// Default contructor
-		Implicit();
-		
-		// Get & Set methods
-		void setDeltat(double t);
-		void setDeltax(double x);
-		void setD_value(double D);
-		void setSpaceDomain(int space);
-		void setTimeDomain(int time);
-		void setT_surf(double Tsurf);
-		void setT_init(double Tinit);
-		
-		// Thomas algorithm resolution: takes a vector T^{n} and return the vector T^{n+1}
-		Vector thomas_algorithm(Vector v);
-		
-		// duFortSolve uses the Laasonen scheme to solve the heat equation.
-		Vector laasonenSolve();
-		
-		// Crank Nicolson uses the Laasonen scheme to solve the heat equation.
-		Vector crankNicolsonSolve();
-};
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef IMPLICIT_H 
+#define IMPLICIT_H
+#include "vector.h"
+#include "observer.h"
+#include "tridiagonal.h"
+#include "batchtridiagonal.h"
+#include "partitionedtridiagonal.h"
+#include <map>
+#include <memory>
+
+
+class Implicit {
+	// Attributes
+	private:
+		Vector A, B, C; // Triadiagonal coefficient--A: coef for T_{i-1}, B:coef for T_{i}, C: coef for T_{i+1}
+		Tridiagonal matrix; // A, B, C factorised once before the time loop
+		std::shared_ptr<PartitionedTridiagonal> partitioned; // multithreaded solver of the large systems, created at the first use
+		bool usePartitioned; // the current factorisation is held by partitioned instead of matrix
+		int threads, parallelThreshold; // threads of the partitioned solver (1: always serial), rows from which it is used
+		double tolerance; // adaptive time stepping: largest local error accepted on a step (K), 0: uniform steps of deltat
+		Vector outputTimes; // times the adaptive march lands on exactly
+		int acceptedSteps, rejectedSteps; // steps of the last adaptive march
+		double steadyTolerance; // the march stops once the largest change of a step is below it (K), 0: never
+		int stoppedStep; // time step at which the last march stopped on the steady state, -1 if it went to the end
+		int precision; // 1: double, 2: float, 3: float storage and double Thomas recurrence
+		bool symmetric; // march only the half of the wall up to the centreline when possible
+		int spaceDomain, timeDomain; // number of nodes for the space and time grids
+		double deltat, deltax, D_value, t_surf, t_init; // respectively: time step, space step, diffusion coefficient, temperature of the sides, initial temperature.
+		std::vector<StepObserver*> observers; // notified with the solution at each time level (probes, recorders...)
+
+		// call every observer with the time level computed at the time step "step"
+		void notifyObservers(int step, const Vector& level);
+		void notifyObservers(int step, double time, const Vector& level);
+
+		// steady state reached at the time step "step": the observers get "level" for the steps left until timeDomain
+		void finishSteady(int step, const Vector& level);
+
+		// add the time steps and the nodes of the last march to the counters of the profiler
+		void countMarch() const;
+
+		// size of the values of the uniform marches (bytes), 4 in single and mixed precision
+		double valueBytes() const;
+
+		// factorise A, B, C with the serial Thomas algorithm, or with the partitioned solver for the systems of parallelThreshold rows or more
+		void factoriseMatrix();
+
+		// solve the system factorised by factoriseMatrix, the solution is written in d
+		void solveMatrix(Vector& d);
+
+		// factorise in m (a Tridiagonal of any precision) the matrix of one step of length dt of the scheme (1: Laasonen, 2: Crank-Nicolson)
+		template<class Matrix>
+		void factoriseStep(int scheme, double dt, Matrix& m);
+
+		// advance the whole level (nodes 0 to spaceDomain) in place by one step of length dt, m being factorised by factoriseStep for this dt
+		void advanceStep(int scheme, double dt, const Tridiagonal& m, Vector& level);
+
+		// adaptive march of the scheme until (timeDomain - 1) * deltat, the same final time as the uniform march
+		Vector adaptiveSolve(int scheme);
+
+		// the half wall is marched instead of the whole one: symmetric mode on, uniform march in double with the serial Thomas algorithm
+		// and nobody looking at the levels
+		bool halfDomain() const;
+		// uniform march of the scheme on the nodes from the left wall to the centreline, the rows of the centreline folding the mirror image
+		// of their neighbour (zero flux); returns the whole wall
+		Vector halfSolve(int scheme);
+
+		// uniform march of the scheme in the reduced precision set by setPrecision, with the serial Thomas algorithm
+		Vector reducedSolve(int scheme);
+		// the levels and the factors stored as Storage, the Thomas recurrence and the right hand side computed in Compute.
+		// The observers and the steady state check get the levels converted to double
+		template<class Storage, class Compute>
+		Vector marchReduced(int scheme);
+
+	public:
+		// Default contructor
+		Implicit();
+		
+		// Get & Set methods
+		void setDeltat(double t);
+		void setDeltax(double x);
+		void setD_value(double D);
+		void setSpaceDomain(int space);
+		void setTimeDomain(int time);
+		void setT_surf(double Tsurf);
+		void setT_init(double Tinit);
+
+		// number of threads solving the tridiagonal systems (default 1: serial Thomas algorithm, <= 0: one per hardware thread)
+		void setThreads(int count);
+		// size of the systems (rows) from which the threads are used, the smaller ones are solved serially (default 100000)
+		void setParallelThreshold(int rowCount);
+
+		// adaptive time stepping if tolerance > 0 (default 0: uniform steps). The local error of a step is estimated by step doubling
+		// (one step against two half steps); the step is halved and taken again while the error exceeds the tolerance (K), and doubled
+		// when the error is well below it. The steps are deltat * 2^k, so every step size is factorised once and reused
+		void setAdaptive(double tol);
+		// times (increasing) on which the adaptive march lands exactly, the observers being notified there as at every step taken
+		void setOutputTimes(const Vector& times);
+		int getAcceptedSteps() const;
+		int getRejectedSteps() const;
+
+		// stop the time march once the largest change of the temperature over a time step (over deltat for the adaptive march) is below tol (K),
+		// 0 (default) never stops early. The solution returned is the converged one, and the observers get it for the remaining steps (or output times)
+		void setSteadyTolerance(double tol);
+		// time step at which the last march stopped on the steady state (accepted steps for the adaptive march), -1 if it went until the end
+		int getStoppedStep() const;
+
+		// precision of the uniform marches: 1 (default) double, 2 float (half the memory traffic), 3 mixed: the levels and the factors
+		// stored in float, the Thomas recurrence carried in double. The adaptive march and the batches stay in double, any other value is taken as 1
+		void setPrecision(int choice);
+
+		// symmetric mode (default off): the setups of this solver (the same t_surf on both sides, a uniform t_init) are symmetric about the
+		// centre of the wall, so the uniform double precision marches of Laasonen and Crank-Nicolson solve only the half up to the centreline
+		// and rebuild the whole profile at the end, when no observer is attached and the system is solved serially
+		void setSymmetric(bool on);
+
+		// the observers are not owned by the solver, they have to outlive the call to the solve methods
+		void addObserver(StepObserver* observer);
+		void clearObservers();
+		
+		// set the three diagonals used by thomas_algorithm (the solve methods set their own)
+		void setDiagonals(const Vector& lower, const Vector& main, const Vector& upper);
+
+		// Thomas algorithm resolution: takes a vector T^{n} and return the vector T^{n+1}
+		Vector thomas_algorithm(Vector v);
+		
+		// duFortSolve uses the Laasonen scheme to solve the heat equation.
+		Vector laasonenSolve();
+		
+		// Crank Nicolson uses the Laasonen scheme to solve the heat equation.
+		Vector crankNicolsonSolve();
+
+		// Batch of K independent walls sharing the grid of this object (deltat, deltax, spaceDomain, timeDomain), each wall k having its own
+		// diffusion coefficient Diffs[k], temperature of the sides Tsurfs[k] and initial temperature Tinits[k].
+		// All the walls are advanced together at each time step by one BatchTridiagonal solve, the solution of the wall k is returned at [k].
+		std::vector<Vector> laasonenSolveBatch(const Vector& Diffs, const Vector& Tsurfs, const Vector& Tinits);
+		std::vector<Vector> crankNicolsonSolveBatch(const Vector& Diffs, const Vector& Tsurfs, const Vector& Tinits);
+};
 #endif
\ No newline at end of file
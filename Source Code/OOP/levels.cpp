@@ -0,0 +1,72 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "levels.h"
+
+
+// Default constructor
+TimeLevels::TimeLevels() {
+	older = 0;
+	current = 1;
+	newer = 2;
+}
+
+void TimeLevels::resize(int nodes) {
+	for (int k = 0; k < 3; k++) {
+		levels[k].resize(nodes);
+	}
+}
+
+// Get methods
+Vector& TimeLevels::previous() {
+	return levels[older];
+}
+
+Vector& TimeLevels::present() {
+	return levels[current];
+}
+
+Vector& TimeLevels::next() {
+	return levels[newer];
+}
+
+// Methods
+void TimeLevels::rotate() {
+	int recycled = older;
+	older = current;
+	current = newer;
+	newer = recycled;
+}
+
+double maxChange(const Vector& a, const Vector& b) {
+	double change = 0;
+	for (int i = 0; i < int(a.size()); i++) {
+		double d = a[i] - b[i];
+		change = (d > change) ? d : ((-d > change) ? -d : change);
+	}
+	return change;
+}
+
+Vector unfoldHalf(const Vector& half, int N) {
+	Vector whole(N + 1);
+	for (int i = 0; i <= N / 2; i++) {
+		whole[i] = half[i];
+		whole[N - i] = half[i];
+	}
+	return whole;
+}
@@ -0,0 +1,56 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef LEVELS_H
+#define LEVELS_H
+#include "vector.h"
+
+
+// Three time levels (n - 1, n and n + 1) used by the two-step explicit schemes.
+// The storage is allocated once, then the levels are only renamed at each time step (rotate),
+// so the time loop does not copy nor allocate anything.
+class TimeLevels {
+	// Attributes
+	private:
+		Vector levels[3]; // storage of the three levels
+		int older, current, newer; // index in levels of respectively the levels n - 1, n and n + 1
+
+	public:
+		// Default contructor
+		TimeLevels();
+
+		// allocate the three levels with "nodes" nodes each
+		void resize(int nodes);
+
+		// Get methods
+		Vector& previous(); // level n - 1
+		Vector& present(); // level n
+		Vector& next(); // level n + 1
+
+		// Methods
+		// shift the levels after a time step: n + 1 becomes n, n becomes n - 1 and the storage of n - 1 is reused for the next n + 1
+		void rotate();
+};
+
+// largest |a_i - b_i|: change of the solution over a time step, used to detect the steady state
+double maxChange(const Vector& a, const Vector& b);
+
+// whole profile of a symmetric wall of N space steps from its half: the nodes 0 to N / 2 of "half" (any node beyond is ignored),
+// each node past the centreline taking the value of its mirror image N - i
+Vector unfoldHalf(const Vector& half, int N);
+#endif
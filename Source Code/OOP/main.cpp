@@ -1,54 +1,92 @@
-/***********************************************************************\
-#                                                                       #
-#                C R A N F I E L D   U N I V E R S I T Y                #
-#                          2 0 1 9  /  2 0 2 0                          #
-#                                                                       #
-#               MSc in Aerospace Computational Engineering              #
-#                                                                       #
-#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
-#                                                                       #
-#-----------------------------------------------------------------------#
-#                                                                       #
-#   Main Contributors:                                                  #
-#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
-#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
-#                                                                       #
-\***********************************************************************/
-
-
-#include "analysis.h"
-using namespace std;
-
-
-int main()
-{
-	// Problem Variables (Diffusivity, DeltaX, DeltaT, Thickness, OutputTime, Tsurf, Tinit, duFortFirstStepMethod);
-	Analysis HeatEquation(93, 0.05, 0.01, 31, 0.5, 149, 38, 1);
-
-	// Exact Analytical Solution for the 1D Heat Equation
-	HeatEquation.print_exact_solution();
-
-	// Numerical Solution Using 4 Different Numerical Schemes
-	HeatEquation.printExplicit_duFordFrankel();
-	HeatEquation.printExplicit_richardson();
-	HeatEquation.printImplicit_laasonen();
-	HeatEquation.printImplicit_crankNicolson();
-	
-	// Absolute Errors for All Numerical Schemes With Respect to the Exact Analytical Solution
-	// HeatEquation.printErrors(numerical_scheme);
-	HeatEquation.printErrors(1);
-	HeatEquation.printErrors(2);
-	HeatEquation.printErrors(3);
-	HeatEquation.printErrors(4);
-	
-	// Numerical solution at a specified location, until a specified time and using a specified numerical scheme
-	// HeatEquation.printTimeFunction(positionToSee, timeToSee, numerical_scheme);
-	HeatEquation.printTimeFunction(5, 0.5, 1);
-	HeatEquation.printTimeFunction(10, 0.5, 2);
-	HeatEquation.printTimeFunction(15.5, 0.5, 3);
-	HeatEquation.printTimeFunction(20, 0.5, 4);
-
-	cout << "Computation Completed!" << endl;
-	system("PAUSE");
-	return 0;
-}
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "analysis.h"
+#include "sweep.h"
+#include "profiler.h"
+#include "memorytracker.h"
+using namespace std;
+
+
+int main()
+{
+	// Memory limit of the solver data in bytes (0: none): an allocation over it throws MemoryLimitExceeded instead of exhausting the memory of the machine
+	// MemoryTracker::instance().setLimit(bytes);
+	MemoryTracker::instance().setLimit(0);
+
+	// Problem Variables (Diffusivity, DeltaX, DeltaT, Thickness, OutputTime, Tsurf, Tinit, duFortFirstStepMethod);
+	Analysis HeatEquation(93, 0.05, 0.01, 31, 0.5, 149, 38, 1);
+
+	// Exact Analytical Solution for the 1D Heat Equation
+	HeatEquation.print_exact_solution();
+
+	// Numerical Solution Using 4 Different Numerical Schemes
+	HeatEquation.printExplicit_duFordFrankel();
+	HeatEquation.printExplicit_richardson();
+	HeatEquation.printImplicit_laasonen();
+	HeatEquation.printImplicit_crankNicolson();
+	
+	// Absolute Errors for All Numerical Schemes With Respect to the Exact Analytical Solution
+	// HeatEquation.printErrors(numerical_scheme);
+	HeatEquation.printErrors(1);
+	HeatEquation.printErrors(2);
+	HeatEquation.printErrors(3);
+	HeatEquation.printErrors(4);
+	
+	// Numerical solution at a specified location, until a specified time and using a specified numerical scheme
+	// HeatEquation.printTimeFunction(positionToSee, timeToSee, numerical_scheme);
+	HeatEquation.printTimeFunction(5, 0.5, 1);
+	HeatEquation.printTimeFunction(10, 0.5, 2);
+	HeatEquation.printTimeFunction(15.5, 0.5, 3);
+	HeatEquation.printTimeFunction(20, 0.5, 4);
+
+	// Numerical solution at several locations (thermocouples, on or between the nodes), recorded during a single time march every "every" time steps
+	// HeatEquation.printProbes(positionsToSee, timeToSee, numerical_scheme, every);
+	Vector thermocouples(4);
+	thermocouples[0] = 1.02;
+	thermocouples[1] = 5;
+	thermocouples[2] = 10.51;
+	thermocouples[3] = 15.5;
+	HeatEquation.printProbes(thermocouples, 0.5, 4, 1);
+
+	// Whole space-time history, every "every" time steps, written by a background thread (AsyncWriter) while the solver keeps stepping:
+	// history_<scheme>.csv, or a .bin file readable by MappedResult after HeatEquation.setOutputFormat(2) (float64) or (3) (float32)
+	// HeatEquation.printHistory(timeToSee, numerical_scheme, every);
+	HeatEquation.printHistory(0.5, 3, 1);
+
+	// Parameter sweep: every combination of the values below, run concurrently on all the cores, gathered in a single .csv file
+	SweepCase base = { 93, 0.05, 0.01, 31, 0.5, 149, 38, 1, 1, 0 }; // Diffusivity, DeltaX, DeltaT, Thickness, OutputTime, Tsurf, Tinit, duFortFirstStepMethod, numerical_scheme, steadyTolerance
+	Vector Diffs(1), dxs(2), dts(2), thicknesses(1);
+	Diffs[0] = 93;
+	dxs[0] = 0.05;
+	dxs[1] = 0.1;
+	dts[0] = 0.01;
+	dts[1] = 0.005;
+	thicknesses[0] = 31;
+	ParameterSweep sweep;
+	sweep.addCartesian(base, Diffs, dxs, dts, thicknesses, { 1, 3 }, { 1, 2, 3, 4 });
+	sweep.run();
+	sweep.print("sweep.csv");
+
+	// time spent in each phase of the run, amount of work done and memory used, for the performance follow-up
+	Profiler::instance().writeReport("profile.json");
+
+	cout << "Computation Completed!" << endl;
+	system("PAUSE");
+	return 0;
+}
@@ -0,0 +1,170 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "memorytracker.h"
+#include "allocator.h"
+#include <sstream>
+using namespace std;
+
+
+static thread_local long long liveOfThread = 0, peakOfThread = 0;
+
+// raise "mark" to "value" if it is lower
+static void raise(atomic<long long>& mark, long long value) {
+	long long current = mark.load(memory_order_relaxed);
+	while (current < value && !mark.compare_exchange_weak(current, value, memory_order_relaxed)) {
+	}
+}
+
+
+// Default constructor
+MemoryLimitExceeded::MemoryLimitExceeded(long long bytes, long long live, long long limit) {
+	stringstream text;
+	text << "memory limit exceeded: " << bytes << " bytes requested with " << live << " bytes in use, limit " << limit << " bytes";
+	message = text.str();
+}
+
+const char* MemoryLimitExceeded::what() const noexcept {
+	return message.c_str();
+}
+
+
+// Default constructor
+MemoryTracker::MemoryTracker() {
+	live.store(0);
+	limit.store(0);
+	reset();
+}
+
+MemoryTracker& MemoryTracker::instance() {
+	static MemoryTracker tracker; // constructed at the first allocation
+	return tracker;
+}
+
+// Get methods
+long long MemoryTracker::getAllocations() const {
+	return allocations.load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getBytesAllocated() const {
+	return bytesAllocated.load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getRefused() const {
+	return refused.load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getLiveBytes() const {
+	return live.load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getPeakBytes() const {
+	return peak.load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getLimit() const {
+	return limit.load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getPhaseAllocations(int phase) const {
+	return phaseAllocations[phase].load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getPhaseBytes(int phase) const {
+	return phaseBytes[phase].load(memory_order_relaxed);
+}
+
+long long MemoryTracker::getPhasePeak(int phase) const {
+	return phasePeak[phase].load(memory_order_relaxed);
+}
+
+long long MemoryTracker::threadLiveBytes() {
+	return liveOfThread;
+}
+
+long long MemoryTracker::threadPeakBytes() {
+	return peakOfThread;
+}
+
+// Set method
+void MemoryTracker::setLimit(long long bytes) {
+	limit.store((bytes > 0) ? bytes : 0);
+}
+
+// Methods
+void MemoryTracker::allocate(size_t bytes) {
+	long long size = (long long)bytes;
+	long long now = live.fetch_add(size, memory_order_relaxed) + size;
+	long long most = limit.load(memory_order_relaxed);
+	if (most > 0 && now > most) {
+		live.fetch_sub(size, memory_order_relaxed);
+		refused.fetch_add(1, memory_order_relaxed);
+		throw MemoryLimitExceeded(size, now - size, most);
+	}
+	allocations.fetch_add(1, memory_order_relaxed);
+	bytesAllocated.fetch_add(size, memory_order_relaxed);
+	raise(peak, now);
+	int phase = Profiler::currentPhase();
+	phaseAllocations[phase].fetch_add(1, memory_order_relaxed);
+	phaseBytes[phase].fetch_add(size, memory_order_relaxed);
+	raise(phasePeak[phase], now);
+	liveOfThread += size;
+	if (liveOfThread > peakOfThread)
+		peakOfThread = liveOfThread;
+}
+
+void MemoryTracker::deallocate(size_t bytes) noexcept {
+	live.fetch_sub((long long)bytes, memory_order_relaxed);
+	liveOfThread -= (long long)bytes;
+}
+
+void MemoryTracker::resetThreadPeak() {
+	peakOfThread = liveOfThread;
+}
+
+void MemoryTracker::reset() {
+	allocations.store(0, memory_order_relaxed);
+	bytesAllocated.store(0, memory_order_relaxed);
+	refused.store(0, memory_order_relaxed);
+	peak.store(live.load(memory_order_relaxed), memory_order_relaxed);
+	for (int p = 0; p <= PhaseCount; p++) {
+		phaseAllocations[p].store(0, memory_order_relaxed);
+		phaseBytes[p].store(0, memory_order_relaxed);
+		phasePeak[p].store(0, memory_order_relaxed);
+	}
+}
+
+void MemoryTracker::report(ostream& out) const {
+	out << "{\"allocations\": " << getAllocations() << ", \"bytes_allocated\": " << getBytesAllocated() << ", \"live_bytes\": " << getLiveBytes()
+		<< ", \"peak_bytes\": " << getPeakBytes() << ", \"limit_bytes\": " << getLimit() << ", \"refused\": " << getRefused() << ",\n    \"phases\": {";
+	for (int p = 0; p <= PhaseCount; p++) {
+		out << (p == 0 ? "\n" : ",\n") << "      \"" << ((p < PhaseCount) ? Profiler::getPhaseName(p) : "other") << "\": {\"allocations\": " << getPhaseAllocations(p)
+			<< ", \"bytes\": " << getPhaseBytes(p) << ", \"peak_bytes\": " << getPhasePeak(p) << "}";
+	}
+	out << "\n    }\n  }";
+}
+
+
+// hooks of AlignedAllocator
+void trackAllocation(size_t bytes) {
+	MemoryTracker::instance().allocate(bytes);
+}
+
+void trackDeallocation(size_t bytes) noexcept {
+	MemoryTracker::instance().deallocate(bytes);
+}
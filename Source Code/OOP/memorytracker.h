@@ -0,0 +1,99 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <ostream>
+#include <string>
+#include "profiler.h" // phases of a run
+
+
+// Thrown instead of allocating when the memory limit of the MemoryTracker would be exceeded: a bad_alloc, so the run stops cleanly
+// (the Vector being built is released, the sweep marks the case as failed) before the system runs out of memory
+class MemoryLimitExceeded : public std::bad_alloc {
+	// Attributes
+	private:
+		std::string message;
+
+	public:
+		// Default contructor: "bytes" requested while "live" bytes were in use, over "limit"
+		MemoryLimitExceeded(long long bytes, long long live, long long limit);
+
+		const char* what() const noexcept override;
+};
+
+
+// Process-wide accounting of the memory of the solver data: every Vector and level buffer allocated through AlignedAllocator.
+// Counts the allocations and bytes, and the high-water mark of the bytes in use (live), in total and per phase of the profiler
+// (Profiler::currentPhase of the allocating thread, "other" outside any phase, or for every allocation when the profiler is compiled out).
+// An optional limit makes the allocations over it throw MemoryLimitExceeded
+class MemoryTracker {
+	// Attributes
+	private:
+		std::atomic<long long> allocations; // allocations since the last reset
+		std::atomic<long long> bytesAllocated; // total size of these allocations
+		std::atomic<long long> refused; // allocations refused by the limit
+		std::atomic<long long> live; // bytes in use now
+		std::atomic<long long> peak; // highest live since the last reset
+		std::atomic<long long> limit; // 0: no limit
+		std::atomic<long long> phaseAllocations[PhaseCount + 1]; // last slot: outside any phase
+		std::atomic<long long> phaseBytes[PhaseCount + 1];
+		std::atomic<long long> phasePeak[PhaseCount + 1]; // highest live while the phase allocated
+
+		// Default contructor: no limit, every total at 0, only the instance exists
+		MemoryTracker();
+
+	public:
+		// the tracker of the process
+		static MemoryTracker& instance();
+
+		// Get methods
+		long long getAllocations() const;
+		long long getBytesAllocated() const;
+		long long getRefused() const;
+		long long getLiveBytes() const;
+		long long getPeakBytes() const;
+		long long getLimit() const;
+		long long getPhaseAllocations(int phase) const; // phase: a ProfilePhase, or PhaseCount outside any phase
+		long long getPhaseBytes(int phase) const;
+		long long getPhasePeak(int phase) const;
+		static long long threadLiveBytes(); // bytes allocated and not released by the calling thread (released by another thread: counted there)
+		static long long threadPeakBytes(); // highest threadLiveBytes since resetThreadPeak
+
+		// Set method: limit of the bytes in use, 0 for none
+		void setLimit(long long bytes);
+
+		// Methods
+		// account for an allocation of "bytes", before it is made
+		// @exception MemoryLimitExceeded if it would take the bytes in use over the limit (nothing is accounted then)
+		void allocate(std::size_t bytes);
+		void deallocate(std::size_t bytes) noexcept;
+
+		static void resetThreadPeak(); // threadPeakBytes back to threadLiveBytes, at the start of a run on this thread
+
+		// set the counts back to 0 and the high-water marks to the bytes in use, e.g. between two runs in the same process
+		void reset();
+
+		// write the totals as a JSON object: {"allocations": ..., "bytes_allocated": ..., "live_bytes": ..., "peak_bytes": ..., "limit_bytes": ...,
+		// "refused": ..., "phases": {"setup": {"allocations": ..., "bytes": ..., "peak_bytes": ...}, ..., "other": {...}}}
+		void report(std::ostream& out) const;
+};
+#endif
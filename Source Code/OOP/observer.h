@@ -0,0 +1,34 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef OBSERVER_H
+#define OBSERVER_H
+#include "vector.h"
+
+
+// Interface for objects hooked into the time loop of the Explicit and Implicit solvers.
+// The solvers call observe() once for every time level they compute, starting with the initial level (step 0),
+// so that anything needed along the time march can be captured without solving the problem again.
+class StepObserver {
+	public:
+		virtual ~StepObserver() {}
+
+		// step: index n of the time level, time: physical time of the level, level: temperature at every node of the grid
+		virtual void observe(int step, double time, const Vector& level) = 0;
+};
+#endif
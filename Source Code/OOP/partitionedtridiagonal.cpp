@@ -0,0 +1,145 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "partitionedtridiagonal.h"
+using namespace std;
+
+
+// Default constructor
+PartitionedTridiagonal::PartitionedTridiagonal(int threads) {
+	pool = unique_ptr<ThreadPool>(new ThreadPool(threads));
+	rows = 0;
+	blocks = 0;
+}
+
+// Get methods
+int PartitionedTridiagonal::getSize() const {
+	return rows;
+}
+
+int PartitionedTridiagonal::getBlockCount() const {
+	return blocks;
+}
+
+int PartitionedTridiagonal::getThreadCount() const {
+	return pool->getThreadCount();
+}
+
+// Methods
+void PartitionedTridiagonal::forEachBlock(const function<void(int)>& task) {
+	for (int p = 0; p < blocks; p++) {
+		pool->submit([&task, p] { task(p); });
+	}
+	pool->wait();
+}
+
+void PartitionedTridiagonal::factorise(const Vector& a, const Vector& b, const Vector& c) {
+	rows = a.size();
+	blocks = min(getThreadCount(), max(1, rows / 2)); // at least 2 rows per block
+	first.resize(blocks + 1);
+	for (int p = 0; p <= blocks; p++) {
+		first[p] = int((long long)(rows) * p / blocks);
+	}
+	parts.resize(blocks);
+	left.refill(rows, 0.0);
+	right.refill(rows, 0.0);
+
+	// factorise every block and compute its spikes, in parallel
+	forEachBlock([&](int p) {
+		int s = first[p], n = first[p + 1] - first[p];
+		Vector la(n), lb(n), lc(n);
+		for (int i = 0; i < n; i++) {
+			la[i] = a[s + i];
+			lb[i] = b[s + i];
+			lc[i] = c[s + i];
+		}
+		parts[p].factorise(la, lb, lc); // a of the first row and c of the last row are the coupling, not used by the factorisation
+		if (p > 0) {
+			left[s] = a[s];
+			parts[p].solve(&left[s]);
+		}
+		if (p < blocks - 1) {
+			right[s + n - 1] = c[s + n - 1];
+			parts[p].solve(&right[s]);
+		}
+	});
+
+	// reduced system: for each block p, u_p = (first, last) unknowns, L_p u_{p-1} + u_p + U_p u_{p+1} = (y_first, y_last),
+	// with L_p = [0 v_first; 0 v_last] (acting on the last unknown of p-1) and U_p = [w_first 0; w_last 0] (on the first unknown of p+1).
+	// Block Thomas elimination: M_p = L_p D_{p-1}^-1, D_p = I - M_p U_{p-1}, only M_p and D_p^-1 are kept
+	reducedMultiplier.refill(4 * blocks, 0.0);
+	reducedInverse.refill(4 * blocks, 0.0);
+	reducedInverse[0] = 1;
+	reducedInverse[3] = 1;
+	for (int p = 1; p < blocks; p++) {
+		int s = first[p], e = first[p + 1] - 1, pe = first[p] - 1, ps = first[p - 1];
+		const double* inv = &reducedInverse[4 * (p - 1)];
+		double* m = &reducedMultiplier[4 * p];
+		m[0] = left[s] * inv[2];
+		m[1] = left[s] * inv[3];
+		m[2] = left[e] * inv[2];
+		m[3] = left[e] * inv[3];
+		double d00 = 1 - (m[0] * right[ps] + m[1] * right[pe]);
+		double d10 = -(m[2] * right[ps] + m[3] * right[pe]); // D_p = [d00 0; d10 1]
+		double* dinv = &reducedInverse[4 * p];
+		dinv[0] = 1 / d00;
+		dinv[1] = 0;
+		dinv[2] = -d10 / d00;
+		dinv[3] = 1;
+	}
+	interfaces.refill(2 * blocks, 0.0);
+}
+
+void PartitionedTridiagonal::solve(Vector& d) {
+	// local solves: d becomes y
+	forEachBlock([&](int p) {
+		parts[p].solve(&d[first[p]]);
+	});
+
+	// reduced system, forward elimination then back substitution on the 2P interface unknowns
+	for (int p = 0; p < blocks; p++) {
+		double f = d[first[p]], l = d[first[p + 1] - 1];
+		if (p > 0) {
+			const double* m = &reducedMultiplier[4 * p];
+			f -= m[0] * interfaces[2 * p - 2] + m[1] * interfaces[2 * p - 1];
+			l -= m[2] * interfaces[2 * p - 2] + m[3] * interfaces[2 * p - 1];
+		}
+		interfaces[2 * p] = f;
+		interfaces[2 * p + 1] = l;
+	}
+	for (int p = blocks - 1; p >= 0; p--) {
+		double f = interfaces[2 * p], l = interfaces[2 * p + 1];
+		if (p < blocks - 1) {
+			double next = interfaces[2 * p + 2]; // first unknown of the block p+1, already solved
+			f -= right[first[p]] * next;
+			l -= right[first[p + 1] - 1] * next;
+		}
+		const double* dinv = &reducedInverse[4 * p];
+		interfaces[2 * p] = dinv[0] * f + dinv[1] * l;
+		interfaces[2 * p + 1] = dinv[2] * f + dinv[3] * l;
+	}
+
+	// correction of every block with the spikes
+	forEachBlock([&](int p) {
+		double previous = (p > 0) ? interfaces[2 * p - 1] : 0; // last unknown of the block p-1
+		double next = (p < blocks - 1) ? interfaces[2 * p + 2] : 0; // first unknown of the block p+1
+		for (int i = first[p]; i < first[p + 1]; i++) {
+			d[i] -= left[i] * previous + right[i] * next;
+		}
+	});
+}
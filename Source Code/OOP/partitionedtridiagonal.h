@@ -0,0 +1,65 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef PARTITIONEDTRIDIAGONAL_H
+#define PARTITIONEDTRIDIAGONAL_H
+#include "vector.h"
+#include "tridiagonal.h"
+#include "threadpool.h"
+#include <memory>
+#include <vector>
+
+
+// Tridiagonal system split into P blocks of consecutive rows, solved by P threads (partitioned / SPIKE algorithm).
+// Each block is solved on its own, as if its neighbours were 0, giving y; the coupling with the neighbours is carried by two spikes
+// v = A_p^-1 (a_s e_first) and w = A_p^-1 (c_e e_last), so that x = y - v * x_{s-1} - w * x_{e+1}.
+// The first and last unknowns of every block form a reduced block tridiagonal system (2x2 blocks, 2P unknowns) solved serially,
+// then every block is corrected with the spikes. The matrix is factorised once (blocks, spikes and reduced system),
+// a solve costs two parallel sweeps over the rows and O(P) serial work.
+class PartitionedTridiagonal {
+	// Attributes
+	private:
+		std::unique_ptr<ThreadPool> pool;
+		int rows, blocks;
+		std::vector<int> first; // first row of each block, first[blocks] = rows
+		std::vector<Tridiagonal> parts; // factorised diagonal block of each part
+		Vector left, right; // spikes v and w, indexed by row (v = 0 in the first block, w = 0 in the last one)
+		Vector reducedMultiplier, reducedInverse; // 2x2 matrices of the block elimination of the reduced system (4 values per block)
+		Vector interfaces; // solution of the reduced system: first and last unknown of each block
+
+		// run task(p) for every block p on the pool and wait for all of them
+		void forEachBlock(const std::function<void(int)>& task);
+
+	public:
+		// Default contructor: "threads" threads and blocks, or one per hardware thread if threads <= 0
+		explicit PartitionedTridiagonal(int threads = 0);
+
+		// Get methods
+		int getSize() const;
+		int getBlockCount() const;
+		int getThreadCount() const;
+
+		// Methods
+		// factorise the matrix of diagonals a (coef for T_{i-1}), b (coef for T_{i}), c (coef for T_{i+1}),
+		// with one block per thread (fewer if the system has less than 2 rows per thread)
+		void factorise(const Vector& a, const Vector& b, const Vector& c);
+
+		// solve the system for the right hand side d, the solution is written in d
+		void solve(Vector& d);
+};
+#endif
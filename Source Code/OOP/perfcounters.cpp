@@ -0,0 +1,161 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "perfcounters.h"
+#include "vector.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+
+// Default constructor
+HardwareCounters::HardwareCounters() {
+#ifdef __linux__
+	static const unsigned long long configs[EventCount] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+#endif
+	for (int e = 0; e < EventCount; e++) {
+		descriptors[e] = -1;
+		values[e] = -1;
+#ifdef __linux__
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = configs[e];
+		attr.disabled = 1;
+		attr.inherit = 1; // the threads created by the kernel (parallel march, partitioned solver) are counted as well
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		descriptors[e] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0)); // this thread, any CPU
+#endif
+	}
+}
+
+HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+	for (int e = 0; e < EventCount; e++) {
+		if (descriptors[e] >= 0)
+			close(descriptors[e]);
+	}
+#endif
+}
+
+// Get methods
+bool HardwareCounters::isAvailable(int event) const {
+	return descriptors[event] >= 0;
+}
+
+bool HardwareCounters::anyAvailable() const {
+	for (int e = 0; e < EventCount; e++) {
+		if (isAvailable(e))
+			return true;
+	}
+	return false;
+}
+
+long long HardwareCounters::getValue(int event) const {
+	return values[event];
+}
+
+// Methods
+void HardwareCounters::start() {
+#ifdef __linux__
+	for (int e = 0; e < EventCount; e++) {
+		if (descriptors[e] < 0)
+			continue;
+		ioctl(descriptors[e], PERF_EVENT_IOC_RESET, 0);
+		ioctl(descriptors[e], PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+void HardwareCounters::stop() {
+#ifdef __linux__
+	for (int e = 0; e < EventCount; e++) {
+		if (descriptors[e] < 0)
+			continue;
+		ioctl(descriptors[e], PERF_EVENT_IOC_DISABLE, 0);
+		long long count = 0;
+		values[e] = (read(descriptors[e], &count, sizeof(count)) == sizeof(count)) ? count : -1;
+	}
+#endif
+}
+
+
+RooflinePoint placeOnRoofline(const Roofline& roofline, double flops, double bytes, double seconds) {
+	RooflinePoint point;
+	point.intensity = flops / bytes;
+	point.achievedGflops = flops / seconds / 1e9;
+	point.attainableGflops = min(roofline.peakGflops, point.intensity * roofline.bandwidth);
+	if (point.achievedGflops > point.attainableGflops && point.attainableGflops < roofline.peakGflops)
+		point.bound = "cache";
+	else
+		point.bound = (point.intensity * roofline.bandwidth < roofline.peakGflops) ? "memory" : "compute";
+	return point;
+}
+
+Roofline measureRoofline() {
+	Roofline roofline;
+
+	// triad on 3 arrays of 128 MB, larger than the last level cache of most machines: the best of 5 runs
+	int n = 1 << 24;
+	Vector a(n), b(n), c(n);
+	for (int i = 0; i < n; i++) { // first touch of every page before the timing
+		a[i] = 0;
+		b[i] = 1;
+		c[i] = 2;
+	}
+	double best = 1e30;
+	for (int run = 0; run < 5; run++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int i = 0; i < n; i++) {
+			a[i] = b[i] + 0.5 * c[i];
+		}
+		best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+	}
+	roofline.bandwidth = 3.0 * sizeof(double) * n / best / 1e9;
+
+	// 32 independent chains x = x * m + s in cache (2 flops each), enough to fill the pipelines of the vector units
+	const int chains = 32, rounds = 4000000;
+	double x[chains];
+	for (int k = 0; k < chains; k++) {
+		x[k] = a[k] + k;
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++) {
+		for (int k = 0; k < chains; k++) {
+			x[k] = x[k] * 0.999999 + 1e-7;
+		}
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	double sum = 0;
+	for (int k = 0; k < chains; k++) {
+		sum += x[k];
+	}
+	volatile double sink = sum; // the chains are used: not removed by the compiler
+	(void)sink;
+	roofline.peakGflops = 2.0 * chains * rounds / seconds / 1e9;
+	return roofline;
+}
@@ -0,0 +1,76 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+
+// Events of the CPU counted around the solver kernels
+enum HardwareEvent {
+	EventCycles,
+	EventInstructions,
+	EventCacheMisses,  // last level cache misses: lines brought from the memory
+	EventBranchMisses,
+	EventCount
+};
+
+
+// Counters of the CPU (Linux perf_event_open) for the calling thread and the threads it creates while they are open.
+// Each event is opened on its own: an event that the processor or the kernel does not give (virtual machines, perf_event_paranoid > 2,
+// other systems than Linux) is only reported as not available, the others are still counted
+class HardwareCounters {
+	// Attributes
+	private:
+		int descriptors[EventCount]; // file descriptor of each event, -1 if it is not available
+		long long values[EventCount]; // counts between the last start and stop
+
+	public:
+		// Default contructor: opens the events, not counting yet
+		HardwareCounters();
+		HardwareCounters(const HardwareCounters&) = delete; // the descriptors are owned by a single object
+		~HardwareCounters();
+
+		// Get methods
+		bool isAvailable(int event) const;
+		bool anyAvailable() const;
+		long long getValue(int event) const; // -1 if the event is not available
+
+		// Methods
+		void start(); // counts from 0
+		void stop(); // stops counting and reads the counts
+};
+
+
+// Roofline of one core, measured on this machine: the memory bandwidth of a STREAM triad a = b + s c on arrays larger than the caches,
+// and the double precision arithmetic throughput of independent multiply-adds kept in registers
+struct Roofline {
+	double bandwidth; // GB/s
+	double peakGflops;
+};
+
+Roofline measureRoofline();
+
+// A kernel on the roofline: arithmetic intensity (flops per byte of memory traffic), GFLOP/s achieved and allowed by the roofline,
+// and what bounds it: "memory", "compute", or "cache" when it runs faster than the memory roof allows (its data stays in the caches)
+struct RooflinePoint {
+	double intensity, achievedGflops, attainableGflops;
+	const char* bound;
+};
+
+RooflinePoint placeOnRoofline(const Roofline& roofline, double flops, double bytes, double seconds);
+#endif
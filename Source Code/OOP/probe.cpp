@@ -0,0 +1,106 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "probe.h"
+#include "profiler.h"
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+using namespace std;
+
+
+// Default contructor
+ProbeRecorder::ProbeRecorder(const Vector& probePositions, double dx, int nodes, int k) {
+	positions = probePositions;
+	every = (k < 1) ? 1 : k;
+
+	// locate every probe once for all, the time loop then only does one multiplication and one addition per probe
+	for (int p = 0; p < positions.getSize(); p++) {
+		double s = positions[p] / dx;
+		int i = int(floor(s));
+		if (i < 0) // probes outside of the wall are clamped to the nearest side
+			i = 0;
+		if (i > nodes - 2)
+			i = nodes - 2;
+		double w = s - i;
+		if (w < 0)
+			w = 0;
+		if (w > 1)
+			w = 1;
+		leftNode.push_back(i);
+		weight.push_back(w);
+	}
+}
+
+// Get methods
+int ProbeRecorder::getProbeCount() const {
+	return positions.getSize();
+}
+
+int ProbeRecorder::getSampleCount() const {
+	return times.getSize();
+}
+
+double ProbeRecorder::getPosition(int probe) const {
+	return positions[probe];
+}
+
+double ProbeRecorder::getTime(int sample) const {
+	return times[sample];
+}
+
+double ProbeRecorder::getValue(int sample, int probe) const {
+	return values[sample * getProbeCount() + probe];
+}
+
+// Methods
+void ProbeRecorder::observe(int step, double time, const Vector& level) {
+	if (step % every != 0)
+		return;
+	times.push_back(time);
+	for (int p = 0; p < getProbeCount(); p++) {
+		int i = leftNode[p];
+		values.push_back((1 - weight[p]) * level[i] + weight[p] * level[i + 1]); // linear interpolation between the nodes i and i+1
+	}
+}
+
+void ProbeRecorder::clear() {
+	times.clear();
+	values.clear();
+}
+
+void ProbeRecorder::write(const string& file) const {
+	PROFILE_SCOPE(PhaseOutput);
+	ofstream outfile(file);
+	if (outfile.is_open()) {
+		outfile << "t (s)";
+		for (int p = 0; p < getProbeCount(); p++) {
+			outfile << "," << "T (K) at x = " << positions[p];
+		}
+		outfile << "\n";
+		for (int s = 0; s < getSampleCount(); s++) {
+			outfile << fixed << setprecision(4) << times[s];
+			for (int p = 0; p < getProbeCount(); p++) {
+				outfile << "," << getValue(s, p);
+			}
+			outfile << "\n";
+		}
+		PROFILE_COUNT(CounterBytesWritten, outfile.tellp());
+		outfile.close();
+	}
+}
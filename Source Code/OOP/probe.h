@@ -0,0 +1,56 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef PROBE_H
+#define PROBE_H
+#include <string>
+#include "observer.h" // a ProbeRecorder is plugged into the solvers as a StepObserver
+
+
+class ProbeRecorder : public StepObserver {
+	// Attributes
+	private:
+		Vector positions; // x location of every probe (thermocouple), they do not need to be on a grid node
+		std::vector<int> leftNode; // index of the grid node on the left of each probe
+		Vector weight; // linear interpolation weight of the node on the right of each probe
+		int every; // a sample is recorded every "every" time steps
+		Vector times; // time of each recorded sample
+		Vector values; // recorded temperatures, stored sample after sample: values[s * number of probes + p]
+
+	public:
+		// Default contructor: probes at the positions given, on a grid of space step dx with nodes nodes, recording every k time steps
+		ProbeRecorder(const Vector& probePositions, double dx, int nodes, int k = 1);
+
+		// Get methods
+		int getProbeCount() const;
+		int getSampleCount() const;
+		double getPosition(int probe) const;
+		double getTime(int sample) const;
+		double getValue(int sample, int probe) const;
+
+		// Methods
+		// called by the solvers at each time level: interpolate the temperature at every probe and store it
+		void observe(int step, double time, const Vector& level);
+
+		// forget all the samples recorded, the probes are kept
+		void clear();
+
+		// write in a .csv file the time history of every probe, one column per probe
+		void write(const std::string& file) const;
+};
+#endif
@@ -0,0 +1,264 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "profiler.h"
+#include "memorytracker.h"
+#include <algorithm>
+#include <fstream>
+using namespace std;
+
+
+static const char* phaseNames[PhaseCount] = { "setup", "time_loop", "tridiagonal_solve", "rhs_assembly", "exact_solution", "output" };
+static const char* counterNames[CounterCount] = { "bytes_written", "steps_taken", "nodes_updated", "steps_skipped" };
+static const char* eventNames[EventCount] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+static thread_local long long nodesOfThread = 0; // nodes updated by the thread, see threadNodes
+static thread_local int phaseOfThread = PhaseCount; // see currentPhase
+
+// write a number, or null for a quantity that could not be measured (negative)
+static void writeValue(ostream& out, double value) {
+	if (value < 0)
+		out << "null";
+	else
+		out << value;
+}
+
+
+// Default constructor
+Profiler::Profiler() {
+	hardware.store(false);
+	roofline.bandwidth = 0;
+	roofline.peakGflops = 0;
+	reset();
+}
+
+Profiler& Profiler::instance() {
+	static Profiler profiler; // constructed at the first use, by a single thread
+	return profiler;
+}
+
+// Get methods
+double Profiler::getSeconds(int phase) const {
+	return nanoseconds[phase].load(memory_order_relaxed) * 1e-9;
+}
+
+long long Profiler::getCalls(int phase) const {
+	return calls[phase].load(memory_order_relaxed);
+}
+
+long long Profiler::getCount(int counter) const {
+	return counters[counter].load(memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+#ifdef HEAT1D_NO_PROFILING
+	return false;
+#else
+	return true;
+#endif
+}
+
+const char* Profiler::getPhaseName(int phase) {
+	return phaseNames[phase];
+}
+
+bool Profiler::getHardwareCounters() const {
+	return hardware.load(memory_order_relaxed);
+}
+
+const Roofline& Profiler::getRoofline() const {
+	return roofline;
+}
+
+KernelStatistics Profiler::getKernel(const string& kernel) const {
+	lock_guard<mutex> guard(kernelLock);
+	map<string, KernelStatistics>::const_iterator found = kernels.find(kernel);
+	if (found != kernels.end())
+		return found->second;
+	KernelStatistics none = {};
+	return none;
+}
+
+// Set method
+void Profiler::setHardwareCounters(bool on) {
+	if (on && roofline.bandwidth == 0)
+		roofline = measureRoofline();
+	hardware.store(on);
+}
+
+// Methods
+void Profiler::addTime(int phase, long long ns, long long count) {
+	nanoseconds[phase].fetch_add(ns, memory_order_relaxed);
+	calls[phase].fetch_add(count, memory_order_relaxed);
+}
+
+void Profiler::add(int counter, long long amount) {
+	counters[counter].fetch_add(amount, memory_order_relaxed);
+	if (counter == CounterNodesUpdated)
+		nodesOfThread += amount;
+}
+
+void Profiler::addKernel(const string& kernel, const KernelStatistics& run) {
+	lock_guard<mutex> guard(kernelLock);
+	map<string, KernelStatistics>::iterator found = kernels.find(kernel);
+	if (found == kernels.end()) {
+		kernels[kernel] = run;
+		return;
+	}
+	KernelStatistics& total = found->second;
+	total.runs += run.runs;
+	total.nodes += run.nodes;
+	total.seconds += run.seconds;
+	total.flops += run.flops;
+	total.modelBytes += run.modelBytes;
+	for (int e = 0; e < EventCount; e++) {
+		total.events[e] = (total.events[e] < 0 || run.events[e] < 0) ? -1 : total.events[e] + run.events[e];
+	}
+}
+
+int Profiler::currentPhase() {
+	return phaseOfThread;
+}
+
+int Profiler::enterPhase(int phase) {
+	int previous = phaseOfThread;
+	phaseOfThread = phase;
+	return previous;
+}
+
+long long Profiler::threadNodes() {
+	return nodesOfThread;
+}
+
+void Profiler::reset() {
+	for (int p = 0; p < PhaseCount; p++) {
+		nanoseconds[p].store(0, memory_order_relaxed);
+		calls[p].store(0, memory_order_relaxed);
+	}
+	for (int c = 0; c < CounterCount; c++) {
+		counters[c].store(0, memory_order_relaxed);
+	}
+	MemoryTracker::instance().reset();
+	lock_guard<mutex> guard(kernelLock);
+	kernels.clear();
+}
+
+void Profiler::report(ostream& out) const {
+	out << "{\n  \"enabled\": " << (isEnabled() ? "true" : "false") << ",\n  \"phases\": {";
+	for (int p = 0; p < PhaseCount; p++) {
+		out << (p == 0 ? "\n" : ",\n") << "    \"" << phaseNames[p] << "\": {\"seconds\": " << getSeconds(p) << ", \"calls\": " << getCalls(p) << "}";
+	}
+	out << "\n  },\n  \"counters\": {";
+	for (int c = 0; c < CounterCount; c++) {
+		out << (c == 0 ? "\n" : ",\n") << "    \"" << counterNames[c] << "\": " << getCount(c);
+	}
+	out << "\n  },\n  \"memory\": ";
+	MemoryTracker::instance().report(out);
+	if (getHardwareCounters()) {
+		out << ",\n  \"roofline\": {\"bandwidth_gb_per_s\": " << roofline.bandwidth << ", \"peak_gflops\": " << roofline.peakGflops
+			<< ", \"ridge_flops_per_byte\": " << roofline.peakGflops / roofline.bandwidth << "},\n  \"kernels\": {";
+		lock_guard<mutex> guard(kernelLock);
+		bool first = true;
+		for (map<string, KernelStatistics>::const_iterator k = kernels.begin(); k != kernels.end(); ++k) {
+			out << (first ? "\n" : ",\n") << "    \"" << k->first << "\": ";
+			writeKernel(out, k->second);
+			first = false;
+		}
+		out << "\n  }";
+	}
+	out << "\n}\n";
+}
+
+void Profiler::writeKernel(ostream& out, const KernelStatistics& k) const {
+	double nodes = (k.nodes > 0) ? double(k.nodes) : 1;
+	out << "{\"runs\": " << k.runs << ", \"nodes_updated\": " << k.nodes << ", \"seconds\": " << k.seconds << ", \"gflops\": " << k.flops / max(k.seconds, 1e-12) / 1e9;
+	for (int e = 0; e < EventCount; e++) {
+		out << ", \"" << eventNames[e] << "_per_node\": ";
+		writeValue(out, (k.events[e] < 0) ? -1 : k.events[e] / nodes);
+	}
+	out << ", \"ipc\": ";
+	writeValue(out, (k.events[EventCycles] > 0 && k.events[EventInstructions] >= 0) ? double(k.events[EventInstructions]) / k.events[EventCycles] : -1);
+
+	// arithmetic intensity: from the lines missed in the last level cache if counted, otherwise from the model of the scheme
+	bool measured = (k.events[EventCacheMisses] > 0);
+	double bytes = measured ? 64.0 * k.events[EventCacheMisses] : k.modelBytes;
+	out << ", \"intensity_from\": \"" << (measured ? "cache_misses" : "model") << "\"";
+	if (bytes > 0 && k.seconds > 0) {
+		RooflinePoint point = placeOnRoofline(roofline, k.flops, bytes, k.seconds);
+		out << ", \"arithmetic_intensity\": " << point.intensity << ", \"attainable_gflops\": " << point.attainableGflops << ", \"bound\": \"" << point.bound << "\"";
+	}
+	out << "}";
+}
+
+void Profiler::writeReport(const string& file) const {
+	ofstream outfile(file);
+	if (outfile.is_open()) {
+		report(outfile);
+		outfile.close();
+	}
+}
+
+
+// Default constructor
+PhaseTimer::PhaseTimer(int profilePhase, int sampleStride, bool startNow) {
+	phase = profilePhase;
+	stride = (sampleStride < 1) ? 1 : sampleStride;
+	intervals = 0;
+	timed = 0;
+	nanoseconds = 0;
+	running = false;
+	previousPhase = PhaseCount;
+	if (startNow)
+		start();
+}
+
+PhaseTimer::~PhaseTimer() {
+	stop();
+	if (timed > 0) // the intervals not timed are assumed as long as the timed ones
+		Profiler::instance().addTime(phase, (long long)(double(nanoseconds) * intervals / timed), intervals);
+}
+
+
+// Default constructor
+KernelScope::KernelScope(const char* kernelName, double flops, double bytes) {
+	kernel = kernelName;
+	flopsPerNode = flops;
+	bytesPerNode = bytes;
+	firstNodes = 0;
+	if (!Profiler::instance().getHardwareCounters())
+		return;
+	firstNodes = Profiler::threadNodes();
+	counters.reset(new HardwareCounters());
+	begin = chrono::steady_clock::now();
+	counters->start();
+}
+
+KernelScope::~KernelScope() {
+	if (!counters)
+		return;
+	counters->stop();
+	KernelStatistics run;
+	run.runs = 1;
+	run.nodes = Profiler::threadNodes() - firstNodes;
+	run.seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+	run.flops = flopsPerNode * run.nodes;
+	run.modelBytes = bytesPerNode * run.nodes;
+	for (int e = 0; e < EventCount; e++) {
+		run.events[e] = counters->getValue(e);
+	}
+	Profiler::instance().addKernel(kernel, run);
+}
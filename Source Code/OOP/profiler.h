@@ -0,0 +1,208 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef PROFILER_H
+#define PROFILER_H
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "perfcounters.h" // hardware counters of the kernels
+
+
+// Phases of a run timed by the profiler. The times are inclusive: the tridiagonal solves and the right hand side assemblies are part of the time loop
+enum ProfilePhase {
+	PhaseSetup,            // initial levels, diagonals and factorisation before the time loop
+	PhaseTimeLoop,         // time march of the solvers
+	PhaseTridiagonalSolve, // forward and back substitutions of the implicit schemes
+	PhaseRhsAssembly,      // right hand side of Crank-Nicolson on the partitioned solver (elsewhere it is fused with the tridiagonal solve)
+	PhaseExactSolution,    // coefficients and evaluation of the analytic solution
+	PhaseOutput,           // formatting and writing of the result files
+	PhaseCount
+};
+
+// Quantities counted by the profiler
+enum ProfileCounter {
+	CounterBytesWritten,  // size of the result files
+	CounterStepsTaken,    // time steps marched by the solvers (accepted steps of the adaptive march)
+	CounterNodesUpdated,  // interior nodes computed: steps * (space domain - 1)
+	CounterStepsSkipped,  // time steps left out by the marches stopped on the steady state
+	CounterCount
+};
+
+
+// Totals of the runs of one kernel (a solver time march) with the hardware counters on
+struct KernelStatistics {
+	long long runs;
+	long long nodes; // nodes updated
+	double seconds;
+	double flops; // floating point operations of the nodes updated, from the operations per node of the scheme
+	double modelBytes; // bytes streamed for the nodes updated, from the arrays read and written per node of the scheme
+	long long events[EventCount]; // -1 if the event was not available
+};
+
+
+// Process-wide totals of the phases and counters, updated by any thread (the solver threads, the background writer...).
+// The solvers use the PROFILE_ macros below, which are compiled out when HEAT1D_NO_PROFILING is defined (cmake -DHEAT1D_PROFILING=OFF):
+// the report then only holds zeros
+class Profiler {
+	// Attributes
+	private:
+		std::atomic<long long> nanoseconds[PhaseCount]; // time spent in each phase
+		std::atomic<long long> calls[PhaseCount]; // number of times each phase was entered
+		std::atomic<long long> counters[CounterCount];
+		std::atomic<bool> hardware; // kernels measured with the hardware counters
+		Roofline roofline; // of this machine, measured when the hardware counters are switched on
+		mutable std::mutex kernelLock; // protects kernels
+		std::map<std::string, KernelStatistics> kernels;
+
+		// Default contructor: every total at 0, only the instance exists
+		Profiler();
+
+		// one kernel of the report, placed on the roofline
+		void writeKernel(std::ostream& out, const KernelStatistics& k) const;
+
+	public:
+		// the profiler of the process
+		static Profiler& instance();
+
+		// Get methods
+		double getSeconds(int phase) const;
+		long long getCalls(int phase) const;
+		long long getCount(int counter) const;
+		static bool isEnabled(); // false if the macros are compiled out
+		static const char* getPhaseName(int phase); // as in the report
+		bool getHardwareCounters() const;
+		const Roofline& getRoofline() const;
+		KernelStatistics getKernel(const std::string& kernel) const; // every total at 0 if the kernel did not run
+
+		// Set method: measure each solver time march with the CPU counters (Linux perf_event_open) and place it on the roofline of the machine,
+		// which is measured when the counters are first switched on (about a second). Off by default
+		void setHardwareCounters(bool on);
+
+		// Methods
+		void addTime(int phase, long long ns, long long count = 1); // count: intervals of the phase in ns
+		void add(int counter, long long amount);
+		void addKernel(const std::string& kernel, const KernelStatistics& run);
+
+		// phase of the calling thread: the innermost running interval of a timer of stride 1, PhaseCount outside any
+		static int currentPhase();
+		static int enterPhase(int phase); // returns the previous phase of the thread
+
+		// nodes updated by the calling thread since it started, for the kernels measured on this thread
+		static long long threadNodes();
+
+		// set every total back to 0, e.g. between two runs in the same process, the memory tracker included
+		void reset();
+
+		// write the totals as a JSON object: {"enabled": ..., "phases": {"setup": {"seconds": ..., "calls": ...}, ...}, "counters": {...}, "memory": {...}},
+		// the memory being the report of the MemoryTracker,
+		// with the hardware counters on: "roofline": {...} and "kernels": {"dufort": {"cycles": ..., "arithmetic_intensity": ..., "bound": ...}, ...}
+		void report(std::ostream& out) const;
+		void writeReport(const std::string& file) const;
+};
+
+
+// Times the intervals of one phase between start() and stop(), accumulated locally and added to the profiler once, at its destruction.
+// While one of its intervals runs, a timer of every interval (stride 1) is the current phase of its thread, charged with its allocations.
+// A phase repeated at every time step is timed on one interval out of "stride" only, the total being scaled to all the intervals:
+// the steps of the small grids take less time than a few reads of the clock
+class PhaseTimer {
+	// Attributes
+	private:
+		int phase, stride;
+		int previousPhase; // phase of the thread before the running interval
+		long long intervals, timed; // intervals started, intervals timed
+		long long nanoseconds; // total time of the intervals timed
+		bool running;
+		std::chrono::steady_clock::time_point begin;
+
+	public:
+		// Default contructor: timer of the phase, started at once if startNow
+		explicit PhaseTimer(int profilePhase, int sampleStride = 1, bool startNow = false);
+		PhaseTimer(const PhaseTimer&) = delete;
+		~PhaseTimer();
+
+		// Methods
+		void start() {
+			if (intervals++ % stride != 0)
+				return;
+			running = true;
+			if (stride == 1)
+				previousPhase = Profiler::enterPhase(phase);
+			begin = std::chrono::steady_clock::now();
+		}
+		void stop() {
+			if (!running)
+				return;
+			running = false;
+			timed++;
+			nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+			if (stride == 1)
+				Profiler::enterPhase(previousPhase);
+		}
+};
+
+// Hardware counters and time of one run of a kernel, from its construction to its destruction, added to the profiler under the kernel name.
+// Does nothing (one atomic read) while the hardware counters of the profiler are off
+class KernelScope {
+	// Attributes
+	private:
+		const char* kernel;
+		double flopsPerNode, bytesPerNode; // model of the scheme: operations and bytes streamed per node updated
+		long long firstNodes; // threadNodes() at the start
+		std::unique_ptr<HardwareCounters> counters; // null when off
+		std::chrono::steady_clock::time_point begin;
+
+	public:
+		// Default contructor: starts measuring the kernel
+		KernelScope(const char* kernelName, double flops, double bytes);
+		KernelScope(const KernelScope&) = delete;
+		~KernelScope();
+};
+
+// stride of a PhaseTimer whose intervals process "nodes" nodes: about one interval timed per 4096 nodes of work
+inline int profileStride(int nodes) {
+	return (nodes >= 4096) ? 1 : 4096 / (nodes > 0 ? nodes : 1);
+}
+
+
+#ifdef HEAT1D_NO_PROFILING
+#define PROFILE_SCOPE(phase)
+#define PROFILE_TIMER(name, phase, stride)
+#define PROFILE_START(name)
+#define PROFILE_STOP(name)
+#define PROFILE_COUNT(counter, amount) ((void)sizeof(amount)) // not evaluated, the variables it names stay used
+#define PROFILE_KERNEL(kernel, flops, bytes)
+#else
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+// time the rest of the enclosing scope
+#define PROFILE_SCOPE(phase) PhaseTimer PROFILE_CONCAT(scopeTimer, __LINE__)(phase, 1, true)
+// timer of the phase, timing the intervals between PROFILE_START(name) and PROFILE_STOP(name), added to the profiler at the end of the scope
+#define PROFILE_TIMER(name, phase, stride) PhaseTimer name(phase, stride)
+#define PROFILE_START(name) name.start()
+#define PROFILE_STOP(name) name.stop()
+#define PROFILE_COUNT(counter, amount) Profiler::instance().add(counter, amount)
+// measure the rest of the enclosing scope as one run of the kernel, which does "flops" operations and streams "bytes" bytes per node updated
+#define PROFILE_KERNEL(kernel, flops, bytes) KernelScope PROFILE_CONCAT(kernelScope, __LINE__)(kernel, flops, bytes)
+#endif
+#endif
@@ -0,0 +1,228 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef SCHEMES_H
+#define SCHEMES_H
+#include "vector.h"
+#include "implicit.h" // the Laasonen start of DuFort-Frankel
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+
+// Policies of the explicit solver core (Explicit::solveWith<Scheme, Start, Boundary>): each combination is compiled into its own time loop,
+// the update of a node being inlined in the sweep of the level, so that the compiler vectorises it without any call or test per node.
+
+// data of the problem seen by the start policies
+struct ExplicitProblem {
+	int spaceDomain; // last node stored: the right wall, or the ghost node beyond the centreline of a half wall
+	int wallDomain; // space steps of the whole wall
+	double deltat, deltax, D_value, t_surf, t_init;
+	double starterFraction; // sub-steps of SubstepFTCSStart: fraction of the FTCS stability limit
+};
+
+// New level on the nodes [from, to) of an explicit scheme from the levels n - 1 (older) and n (present): shared by the plain sweep,
+// the tiled and the parallel marches, so that they all give the same bits
+typedef void (*LevelKernel)(double a, const double* older, const double* present, double* next, int from, int to);
+
+
+// Schemes: coefficients computed once from a = 2 D dt / dx^2, and the new value of one node (flopsPerNode operations, for the profiler)
+struct DuFortFrankel {
+	static constexpr double flopsPerNode = 4;
+	template<class Real>
+	struct Coefficients {
+		Real older, neighbours;
+	};
+	template<class Real>
+	static Coefficients<Real> coefficients(double a) {
+		Coefficients<Real> c;
+		c.older = Real((1 - a) / (1 + a));
+		c.neighbours = Real(a / (1 + a));
+		return c;
+	}
+	template<class Real>
+	static Real update(const Coefficients<Real>& c, Real older, Real left, Real, Real right) { // the centre node is not used
+		return c.older * older + c.neighbours * (right + left);
+	}
+};
+
+struct Richardson {
+	static constexpr double flopsPerNode = 5;
+	template<class Real>
+	struct Coefficients {
+		Real a;
+	};
+	template<class Real>
+	static Coefficients<Real> coefficients(double a) {
+		Coefficients<Real> c;
+		c.a = Real(a);
+		return c;
+	}
+	template<class Real>
+	static Real update(const Coefficients<Real>& c, Real older, Real left, Real centre, Real right) {
+		return older + c.a * (right - 2*centre + left);
+	}
+};
+
+// the levels are stored as Storage and every node is computed in Compute (float storage and double arithmetic: mixed precision).
+// levelKernel<Scheme> is the double precision kernel of the LevelKernel type
+template<class Scheme, class Storage = double, class Compute = Storage>
+void levelKernel(double a, const Storage* __restrict older, const Storage* __restrict present, Storage* __restrict next, int from, int to) {
+	const typename Scheme::template Coefficients<Compute> c = Scheme::template coefficients<Compute>(a);
+	for (int i = from; i < to; i++) {
+		next[i] = Storage(Scheme::update(c, Compute(older[i]), Compute(present[i - 1]), Compute(present[i]), Compute(present[i + 1])));
+	}
+}
+
+
+// Boundary conditions: value of the walls on every new level (apply, before the scheme), nodes [first, end) left to the scheme,
+// and the nodes following the ones computed (close, after the scheme). N is the last node stored (lastNode of the wall)
+struct FixedSurfaces { // both sides at t_surf (Dirichlet)
+	static constexpr bool mirrored = false;
+	static int lastNode(int wallDomain) {
+		return wallDomain;
+	}
+	template<class Real>
+	static void apply(Real* level, int N, double t_surf) {
+		level[0] = Real(t_surf);
+		level[N] = Real(t_surf);
+	}
+	template<class Real>
+	static void close(Real*, int) { // nothing follows the right wall
+	}
+	static int first() {
+		return 1;
+	}
+	static int end(int N) {
+		return N;
+	}
+};
+
+// Half of a symmetric wall (the same temperature on both sides, a uniform initial temperature): the nodes from the left wall to the
+// centreline, followed by a ghost node holding the mirror image of the node "Gap" before it, so that no heat crosses the centreline.
+// The solution of the whole wall is rebuilt by unfoldHalf
+template<int Gap>
+struct MirrorCentre {
+	static constexpr bool mirrored = true;
+	static int lastNode(int wallDomain) { // ghost node: wallDomain / 2 + 1
+		return wallDomain / 2 + 1;
+	}
+	template<class Real>
+	static void apply(Real* level, int, double t_surf) { // the left wall only
+		level[0] = Real(t_surf);
+	}
+	template<class Real>
+	static void close(Real* level, int N) {
+		level[N] = level[N - Gap];
+	}
+	static int first() {
+		return 1;
+	}
+	static int end(int N) {
+		return N;
+	}
+};
+typedef MirrorCentre<2> MirrorOnNode; // even number of space steps: the centreline is the node N / 2, mirrored around it
+typedef MirrorCentre<1> MirrorBetweenNodes; // odd number: the centreline lies between the nodes (N - 1) / 2 and (N + 1) / 2
+
+
+// Start methods: levels n = 0 (v1) and n = 1 (v2) before the two-step scheme can be used
+template<class Boundary>
+void initialLevel(const ExplicitProblem& p, Vector& v1) { // t_init inside, the walls given by the boundary condition
+	for (int i = 0; i <= p.spaceDomain; i++) {
+		v1[i] = p.t_init;
+	}
+	Boundary::apply(&v1[0], p.spaceDomain, p.t_surf);
+}
+
+struct FTCSStart { // 1: the first step with the FTCS scheme (forward in time, central in space)
+	template<class Boundary>
+	static void start(const ExplicitProblem& p, Vector& v1, Vector& v2) {
+		double a = 2 * p.D_value * p.deltat / (p.deltax * p.deltax);
+		initialLevel<Boundary>(p, v1);
+		for (int i = Boundary::first(); i < Boundary::end(p.spaceDomain); i++) {
+			v2[i] = (a / 2) * v1[i - 1] + (1 - a) * v1[i] + (a / 2) * v1[i + 1];
+		}
+		Boundary::apply(&v2[0], p.spaceDomain, p.t_surf);
+		Boundary::close(&v2[0], p.spaceDomain);
+	}
+};
+
+struct ConstantStart { // 2: every node at t_init at t = 0, the sides at t_surf from the first step
+	template<class Boundary>
+	static void start(const ExplicitProblem& p, Vector& v1, Vector& v2) {
+		for (int i = 0; i <= p.spaceDomain; i++) {
+			v1[i] = p.t_init;
+		}
+		initialLevel<Boundary>(p, v2);
+	}
+};
+
+struct LaasonenStart { // 3: the first step with the Laasonen simple implicit scheme
+	template<class Boundary>
+	static void start(const ExplicitProblem& p, Vector& v1, Vector& v2) {
+		initialLevel<Boundary>(p, v1);
+		Implicit laassonen;
+		laassonen.setDeltat(p.deltat);
+		laassonen.setDeltax(p.deltax);
+		laassonen.setSpaceDomain(p.wallDomain);
+		laassonen.setTimeDomain(2); // use this method only for the first time step: levels 0 and 1
+		laassonen.setD_value(p.D_value);
+		laassonen.setT_init(p.t_init);
+		laassonen.setT_surf(p.t_surf);
+		laassonen.setSymmetric(Boundary::mirrored);
+		Vector whole = laassonen.laasonenSolve();
+		v2.assign(whole.begin(), whole.begin() + p.spaceDomain + 1); // on a half wall, the node of the ghost holds the mirror image already
+	}
+};
+
+struct SubstepFTCSStart { // 4: the first time step with FTCS sub-steps, each within the stability limit of FTCS
+	// number of equal sub-steps of the first time step: the fewest whose length is at most starterFraction of the stability limit dx^2 / (2 D)
+	static int substeps(const ExplicitProblem& p) {
+		double longest = p.starterFraction * p.deltax * p.deltax / (2 * p.D_value);
+		return (longest > 0) ? std::max(1, int(std::ceil(p.deltat / longest - 1e-9))) : 1;
+	}
+	template<class Boundary>
+	static void start(const ExplicitProblem& p, Vector& v1, Vector& v2) {
+		initialLevel<Boundary>(p, v1);
+		int n = substeps(p);
+		double b = 2 * p.D_value * (p.deltat / n) / (p.deltax * p.deltax); // n sub-steps end exactly at deltat
+		Vector spare(v1); // the sub-steps go from one buffer to the other: spare and v2, the last one writing v2
+		v2 = v1;
+		Vector* from = (n % 2 == 1) ? &spare : &v2;
+		Vector* to = (n % 2 == 1) ? &v2 : &spare;
+		for (int s = 0; s < n; s++) {
+			const double* u = &(*from)[0];
+			double* w = &(*to)[0];
+			for (int i = Boundary::first(); i < Boundary::end(p.spaceDomain); i++) {
+				w[i] = (b / 2) * u[i - 1] + (1 - b) * u[i] + (b / 2) * u[i + 1];
+			}
+			Boundary::apply(w, p.spaceDomain, p.t_surf);
+			Boundary::close(w, p.spaceDomain);
+			std::swap(from, to);
+		}
+	}
+};
+
+struct InvalidStart { // any other choice: the levels are left at 0
+	template<class Boundary>
+	static void start(const ExplicitProblem&, Vector&, Vector&) {
+		std::cout << "ERROR! ENTER A VALUE OF 1, 2, 3 or 4 ONLY: ";
+	}
+};
+#endif
@@ -0,0 +1,53 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "snapshot.h"
+
+
+// Default contructor
+SnapshotRecorder::SnapshotRecorder(const Vector& snapshotTimes, double dt) {
+	outputTimes = snapshotTimes;
+	eps = 1e-9 * dt; // same rounding allowance as the adaptive march landing on its output times
+}
+
+// Get methods
+int SnapshotRecorder::getSnapshotCount() const {
+	return times.getSize();
+}
+
+double SnapshotRecorder::getTime(int snapshot) const {
+	return times[snapshot];
+}
+
+const Vector& SnapshotRecorder::getProfile(int snapshot) const {
+	return profiles[snapshot];
+}
+
+// Methods
+void SnapshotRecorder::observe(int, double time, const Vector& level) { // by time, whatever the step
+	// several output times can fall on the same level
+	while (getSnapshotCount() < outputTimes.getSize() && time >= outputTimes[getSnapshotCount()] - eps) {
+		times.push_back(time);
+		profiles.push_back(level);
+	}
+}
+
+void SnapshotRecorder::clear() {
+	times.clear();
+	profiles.clear();
+}
@@ -0,0 +1,52 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include <vector>
+#include "observer.h" // a SnapshotRecorder is plugged into the solvers as a StepObserver
+
+
+// Keeps the whole temperature profile at a few chosen times of a single time march, instead of restarting the march from t = 0 for each time.
+// The level kept for an output time is the first one whose time reaches it (up to the rounding of the times), so the output times are
+// expected on the time levels of the march: multiples of deltat for the uniform marches, the output times of the adaptive one.
+class SnapshotRecorder : public StepObserver {
+	// Attributes
+	private:
+		Vector outputTimes; // times wanted, increasing
+		double eps; // a level at a time closer than eps before an output time is taken for it
+		Vector times; // time of each level kept
+		std::vector<Vector> profiles; // the levels kept, one per output time reached
+
+	public:
+		// Default contructor: levels kept at the times given (increasing), for a march of time step dt
+		SnapshotRecorder(const Vector& snapshotTimes, double dt);
+
+		// Get methods
+		int getSnapshotCount() const; // output times reached so far
+		double getTime(int snapshot) const; // time of the level kept for the output time "snapshot"
+		const Vector& getProfile(int snapshot) const;
+
+		// Methods
+		// called by the solvers at each time level: the level is copied for every output time it reaches
+		void observe(int step, double time, const Vector& level);
+
+		// forget all the levels kept, the output times are kept
+		void clear();
+};
+#endif
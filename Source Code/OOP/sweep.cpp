@@ -0,0 +1,163 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "sweep.h"
+#include "threadpool.h"
+#include "profiler.h"
+#include "memorytracker.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+using namespace std;
+
+
+// Default constructor
+ParameterSweep::ParameterSweep(int threadCount) {
+	threads = threadCount;
+}
+
+// Get methods
+int ParameterSweep::getCaseCount() const {
+	return int(cases.size());
+}
+
+const SweepResult& ParameterSweep::getResult(int k) const {
+	return results[k];
+}
+
+// Methods
+void ParameterSweep::addCase(const SweepCase& c) {
+	cases.push_back(c);
+}
+
+void ParameterSweep::addCartesian(const SweepCase& base, const Vector& Diffs, const Vector& dxs, const Vector& dts, const Vector& thicknesses, const vector<int>& DufortFirstStepMethods, const vector<int>& numerical_schemes) {
+	SweepCase c = base;
+	for (int d = 0; d < Diffs.getSize(); d++) {
+		c.D_value = Diffs[d];
+		for (int x = 0; x < dxs.getSize(); x++) {
+			c.deltax = dxs[x];
+			for (int t = 0; t < dts.getSize(); t++) {
+				c.deltat = dts[t];
+				for (int l = 0; l < thicknesses.getSize(); l++) {
+					c.thickness = thicknesses[l];
+					for (int s = 0; s < int(numerical_schemes.size()); s++) {
+						c.numerical_scheme = numerical_schemes[s];
+						if (c.numerical_scheme == 1) { // the first step method only matters for DuFort-Frankel
+							for (int m = 0; m < int(DufortFirstStepMethods.size()); m++) {
+								c.DufortFirstStepMethod = DufortFirstStepMethods[m];
+								cases.push_back(c);
+							}
+						}
+						else {
+							c.DufortFirstStepMethod = base.DufortFirstStepMethod;
+							cases.push_back(c);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+double ParameterSweep::cost(const SweepCase& c) {
+	double nodes = int(c.thickness / c.deltax) + 1;
+	double steps = int(c.outputTime / c.deltat);
+	return nodes * steps;
+}
+
+SweepResult ParameterSweep::runCase(const SweepCase& c) {
+	SweepResult r;
+	r.parameters = c;
+	r.nodes = int(c.thickness / c.deltax) + 1;
+	r.steps = int(c.outputTime / c.deltat);
+	r.stoppedStep = -1;
+	MemoryTracker::resetThreadPeak();
+	long long before = MemoryTracker::threadLiveBytes();
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Vector numerical, exact;
+	try {
+		Analysis analysis(c.D_value, c.deltax, c.deltat, c.thickness, c.outputTime, c.t_surf, c.t_init, c.DufortFirstStepMethod);
+		analysis.setSteadyTolerance(c.steadyTolerance);
+		numerical = analysis.solve(c.numerical_scheme);
+		r.stoppedStep = analysis.getStoppedStep();
+		exact = analysis.exact_solution();
+		r.completed = true;
+	}
+	catch (const MemoryLimitExceeded&) {
+		r.completed = false;
+	}
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	r.peakBytes = MemoryTracker::threadPeakBytes() - before;
+	r.seconds = chrono::duration<double>(end - start).count();
+	if (!r.completed) {
+		r.maxError = r.rmsError = r.centreTemperature = NAN;
+		return r;
+	}
+
+	double sum = 0;
+	r.maxError = 0;
+	for (int i = 0; i < exact.getSize() && i < numerical.getSize(); i++) {
+		double e = fabs(numerical[i] - exact[i]);
+		r.maxError = max(r.maxError, e);
+		sum += e * e;
+	}
+	r.rmsError = (exact.getSize() > 0) ? sqrt(sum / exact.getSize()) : 0;
+	r.centreTemperature = (numerical.getSize() > 0) ? numerical[numerical.getSize() / 2] : 0;
+	return r;
+}
+
+void ParameterSweep::run() {
+	results.assign(cases.size(), SweepResult());
+
+	// longest cases first: the pool runs the tasks of each queue in the order they were submitted, and an idle worker steals the oldest
+	// task of another queue, so the expensive cases never wait behind a busy worker while cheap ones are stolen
+	vector<int> order(cases.size());
+	for (int k = 0; k < int(order.size()); k++) {
+		order[k] = k;
+	}
+	stable_sort(order.begin(), order.end(), [this](int i, int j) { return cost(cases[i]) > cost(cases[j]); });
+
+	ThreadPool pool(threads);
+	for (int k = 0; k < int(order.size()); k++) {
+		int index = order[k];
+		pool.submit([this, index] { results[index] = runCase(cases[index]); }); // each task writes its own slot, no lock needed
+	}
+	pool.wait();
+}
+
+void ParameterSweep::print(const string& file) const {
+	PROFILE_SCOPE(PhaseOutput);
+	ofstream outfile(file);
+	if (outfile.is_open()) {
+		outfile << "Diffusivity,Dx,Dt,Thickness,OutputTime,Tsurf,Tinit,DufortFirstStepMethod,Scheme,Nodes,Steps,MaxError,RmsError,T centre (K),Time (s),Peak memory (bytes),Steady step,Status" << "\n";
+		for (int k = 0; k < int(results.size()); k++) {
+			const SweepResult& r = results[k];
+			const SweepCase& c = r.parameters;
+			outfile << c.D_value << "," << c.deltax << "," << c.deltat << "," << c.thickness << "," << c.outputTime << "," << c.t_surf << "," << c.t_init << ","
+				<< c.DufortFirstStepMethod << "," << c.numerical_scheme << "," << r.nodes << "," << r.steps << ","
+				<< scientific << setprecision(6) << r.maxError << "," << r.rmsError << ","
+				<< fixed << setprecision(4) << r.centreTemperature << "," << setprecision(6) << r.seconds << "," << r.peakBytes << "," << r.stoppedStep << "," << (r.completed ? "ok" : "memory limit") << "\n";
+			outfile << defaultfloat;
+		}
+		PROFILE_COUNT(CounterBytesWritten, outfile.tellp());
+		outfile.close();
+	}
+}
@@ -0,0 +1,85 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef SWEEP_H
+#define SWEEP_H
+#include <string>
+#include "analysis.h" // each case of the sweep is an Analysis
+
+
+// Parameters of one case of a sweep, same meaning as the arguments of the Analysis constructor
+struct SweepCase {
+	double D_value, deltax, deltat, thickness, outputTime, t_surf, t_init;
+	int DufortFirstStepMethod;
+	int numerical_scheme; // 1: DuFort-Frankel, 2: Richardson, 3: Laasonen, 4: Crank-Nicolson
+	double steadyTolerance; // the solver stops once the change per time step is below it (K), 0: never
+};
+
+
+// Outcome of one case of a sweep
+struct SweepResult {
+	SweepCase parameters;
+	int nodes, steps;
+	double maxError, rmsError; // respectively: uniform and root mean square norms of the error against the exact solution
+	double centreTemperature; // numerical temperature in the middle of the wall
+	double seconds; // wall clock time of the case
+	long long peakBytes; // high-water mark of the solver data allocated by the case (MemoryTracker)
+	bool completed; // false if the case was stopped by the memory limit: its errors and temperature are NaN
+	int stoppedStep; // time step at which the solver reached the steady state, -1 if it ran to the output time
+};
+
+
+// Runs many Analysis cases concurrently on a work-stealing ThreadPool.
+// The cases are started longest first, their cost being estimated by nodes x time steps,
+// so that the big cases do not end up alone at the end of the sweep. The results are gathered in one .csv file.
+// With a memory limit set on the MemoryTracker, a case that would exceed it is stopped and reported as such, the others carry on.
+class ParameterSweep {
+	// Attributes
+	private:
+		std::vector<SweepCase> cases;
+		std::vector<SweepResult> results; // in the order the cases were added
+		int threads; // size of the pool, one thread per hardware thread if <= 0
+
+		// run a single case, called concurrently by the workers of the pool, catches MemoryLimitExceeded
+		SweepResult runCase(const SweepCase& c);
+
+	public:
+		// Default contructor
+		ParameterSweep(int threadCount = 0);
+
+		// Get methods
+		int getCaseCount() const;
+		const SweepResult& getResult(int k) const;
+
+		// Methods
+		// add a single case (list-based sweeps)
+		void addCase(const SweepCase& c);
+
+		// add the Cartesian product of the values given, the other parameters being taken from "base"
+		void addCartesian(const SweepCase& base, const Vector& Diffs, const Vector& dxs, const Vector& dts, const Vector& thicknesses, const std::vector<int>& DufortFirstStepMethods, const std::vector<int>& numerical_schemes);
+
+		// estimated cost of a case: nodes x time steps
+		static double cost(const SweepCase& c);
+
+		// run every case, blocks until the whole sweep is finished
+		void run();
+
+		// write in a .csv file one line per case: parameters, errors, computation time, peak memory and status ("ok" or "memory limit")
+		void print(const std::string& file) const;
+};
+#endif
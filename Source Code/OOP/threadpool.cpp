@@ -0,0 +1,149 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "threadpool.h"
+using namespace std;
+
+
+// index of the worker running the current thread, -1 outside of the pools
+static thread_local int workerIndex = -1;
+static thread_local const ThreadPool* workerPool = nullptr;
+
+
+// Default constructor
+ThreadPool::ThreadPool(int threads) {
+	if (threads <= 0)
+		threads = int(thread::hardware_concurrency());
+	if (threads <= 0) // hardware_concurrency is allowed to return 0
+		threads = 1;
+	queued = 0;
+	unfinished = 0;
+	nextQueue = 0;
+	stopping = false;
+	for (int k = 0; k < threads; k++) {
+		queues.push_back(unique_ptr<TaskQueue>(new TaskQueue()));
+	}
+	for (int k = 0; k < threads; k++) {
+		workers.push_back(thread(&ThreadPool::run, this, k));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	waitIdle();
+	{
+		lock_guard<mutex> guard(stateLock);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+	for (int k = 0; k < int(workers.size()); k++) {
+		workers[k].join();
+	}
+}
+
+// Get method
+int ThreadPool::getThreadCount() const {
+	return int(queues.size()); // the queues are all created before the workers start
+}
+
+// Methods
+void ThreadPool::submit(function<void()> task) {
+	int id;
+	if (workerPool == this) // submitted by one of our workers: kept local, the others will steal it if they are idle
+		id = workerIndex;
+	else
+		id = nextQueue++ % getThreadCount();
+	unfinished++;
+	{
+		lock_guard<mutex> guard(queues[id]->lock);
+		queues[id]->tasks.push_back(move(task));
+	}
+	{
+		lock_guard<mutex> guard(stateLock);
+		queued++;
+	}
+	taskAvailable.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+	unique_lock<mutex> guard(stateLock);
+	allDone.wait(guard, [this] { return unfinished == 0; });
+}
+
+void ThreadPool::wait() {
+	waitIdle();
+	exception_ptr thrown;
+	{
+		lock_guard<mutex> guard(stateLock);
+		swap(thrown, failure);
+	}
+	if (thrown)
+		rethrow_exception(thrown);
+}
+
+bool ThreadPool::takeTask(int id, function<void()>& task) {
+	int n = getThreadCount();
+	{ // own queue first, in the order the tasks were submitted
+		lock_guard<mutex> guard(queues[id]->lock);
+		if (!queues[id]->tasks.empty()) {
+			task = move(queues[id]->tasks.front());
+			queues[id]->tasks.pop_front();
+			queued--;
+			return true;
+		}
+	}
+	for (int k = 1; k < n; k++) { // then steal the oldest task of the other queues, starting with the next worker
+		TaskQueue& victim = *queues[(id + k) % n];
+		lock_guard<mutex> guard(victim.lock);
+		if (!victim.tasks.empty()) {
+			task = move(victim.tasks.front());
+			victim.tasks.pop_front();
+			queued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::run(int id) {
+	workerIndex = id;
+	workerPool = this;
+	function<void()> task;
+	while (true) {
+		if (takeTask(id, task)) {
+			try {
+				task();
+			}
+			catch (...) { // kept for wait(): an exception leaving the thread would terminate the program
+				lock_guard<mutex> guard(stateLock);
+				if (!failure)
+					failure = current_exception();
+			}
+			task = nullptr;
+			if (--unfinished == 0) {
+				lock_guard<mutex> guard(stateLock);
+				allDone.notify_all();
+			}
+			continue;
+		}
+		// nothing to run: sleep until a task is submitted or the pool is destroyed
+		unique_lock<mutex> guard(stateLock);
+		taskAvailable.wait(guard, [this] { return stopping || queued > 0; });
+		if (stopping && queued == 0)
+			return;
+	}
+}
@@ -0,0 +1,81 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Pool of worker threads with one task queue per worker and work stealing.
+// Tasks submitted from outside the pool are dealt round-robin to the queues, tasks submitted by a worker go to its own queue.
+// A worker takes its tasks from the front of its queue (so they run in the order submitted) and, once it is empty,
+// steals from the front of the other queues too, so that no thread is idle while tasks are left anywhere: the task stolen is the oldest one
+// of its queue, the largest one when the tasks are submitted longest first (as ParameterSweep does).
+class ThreadPool {
+	// Attributes
+	private:
+		struct TaskQueue {
+			std::deque<std::function<void()>> tasks;
+			std::mutex lock;
+		};
+		std::vector<std::unique_ptr<TaskQueue>> queues; // one queue per worker
+		std::vector<std::thread> workers;
+		std::mutex stateLock; // protects the sleeping of the workers and of wait()
+		std::condition_variable taskAvailable, allDone;
+		std::atomic<int> queued; // tasks waiting in the queues
+		std::atomic<int> unfinished; // tasks submitted and not finished yet
+		std::atomic<int> nextQueue; // round-robin dealing of the tasks submitted from outside the pool
+		bool stopping;
+		std::exception_ptr failure; // first exception thrown by a task since the last wait(), protected by stateLock
+
+		// block until every task submitted is finished
+		void waitIdle();
+
+		// main loop of the worker "id"
+		void run(int id);
+
+		// take a task from the queue "id", or steal one from another queue, return false if every queue is empty
+		bool takeTask(int id, std::function<void()>& task);
+
+	public:
+		// Default contructor: "threads" workers, or one per hardware thread if threads <= 0
+		explicit ThreadPool(int threads = 0);
+
+		// wait for the tasks left, then stop the workers (an exception of a task not collected by wait() is dropped)
+		~ThreadPool();
+
+		// Get method
+		int getThreadCount() const;
+
+		// Methods
+		// queue a task, it can be called from inside a task
+		void submit(std::function<void()> task);
+
+		// block until every task submitted is finished (not to be called from inside a task), then rethrow the first exception
+		// thrown by a task since the last call, if any. The other tasks run to the end: the worker that caught it goes on with its queue
+		void wait();
+};
+#endif
@@ -0,0 +1,118 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#include "tridiagonal.h"
+
+
+// Default constructor
+template<class Storage, class Compute>
+BasicTridiagonal<Storage, Compute>::BasicTridiagonal() {
+	lower = {};
+	upper = {};
+	pivot = {};
+}
+
+// Get method
+template<class Storage, class Compute>
+int BasicTridiagonal<Storage, Compute>::getSize() const {
+	return int(pivot.size());
+}
+
+// Methods
+template<class Storage, class Compute>
+void BasicTridiagonal<Storage, Compute>::factorise(const Vector& a, const Vector& b, const Vector& c) {
+	int n = a.size();
+	lower.assign(a.begin(), a.end());
+	upper.assign(n, Storage(0)); // the storage of a previous factorisation is reused
+	pivot.assign(n, Storage(0));
+
+	// row 0 divided by b_0
+	double p = 1 / b[0];
+	double u = c[0] * p;
+	pivot[0] = Storage(p);
+	upper[0] = Storage(u);
+	for (int i = 1; i < n; i++) { // row i -= row_{i-1} * a_i, then divided by the new b_i
+		p = 1 / (b[i] - u * a[i]);
+		u = c[i] * p;
+		pivot[i] = Storage(p);
+		upper[i] = Storage(u);
+	}
+}
+
+template<class Storage, class Compute>
+void BasicTridiagonal<Storage, Compute>::solve(AlignedVector<Storage>& d) const {
+	solve(&d[0]);
+}
+
+template<class Storage, class Compute>
+void BasicTridiagonal<Storage, Compute>::solve(Storage* d) const {
+	int n = getSize();
+
+	// forward substitution, using the stored reciprocal pivots; the value of the previous row is carried in Compute precision
+	Compute carried = Compute(d[0]) * Compute(pivot[0]);
+	d[0] = Storage(carried);
+	for (int i = 1; i < n; i++) {
+		carried = (Compute(d[i]) - carried * Compute(lower[i])) * Compute(pivot[i]);
+		d[i] = Storage(carried);
+	}
+	// back substitution: d_{n} is already the solution
+	for (int i = n - 2; i >= 0; i--) {
+		carried = Compute(d[i]) - Compute(upper[i]) * carried;
+		d[i] = Storage(carried);
+	}
+}
+
+
+template<class Storage, class Compute>
+void BasicTridiagonal<Storage, Compute>::solveStencil(Compute side, Compute centre, Compute firstWall, Compute lastWall, Storage* level) const {
+	int n = getSize();
+	if (n == 0)
+		return;
+
+	// forward substitution: row i reads the old level[i], level[i + 1] (carried in west, here) and level[i + 2], then overwrites level[i + 1].
+	// The first and the last rows, which get the wall, are peeled out of the loop
+	Compute west = Compute(level[0]), here = Compute(level[1]), east = Compute(level[2]);
+	Compute d = side * west + centre * here + side * east + firstWall;
+	if (n == 1)
+		d += lastWall; // both walls next to the single row
+	Compute carried = d * Compute(pivot[0]);
+	level[1] = Storage(carried);
+	for (int i = 1; i < n - 1; i++) {
+		west = here;
+		here = east;
+		east = Compute(level[i + 2]);
+		carried = (side * west + centre * here + side * east - carried * Compute(lower[i])) * Compute(pivot[i]);
+		level[i + 1] = Storage(carried);
+	}
+	if (n > 1) {
+		d = side * here + centre * east + side * Compute(level[n + 1]) + lastWall;
+		carried = (d - carried * Compute(lower[n - 1])) * Compute(pivot[n - 1]);
+		level[n] = Storage(carried);
+	}
+	// back substitution in place: level[n] is already the solution
+	for (int i = n - 2; i >= 0; i--) {
+		carried = Compute(level[i + 1]) - Compute(upper[i]) * carried;
+		level[i + 1] = Storage(carried);
+	}
+}
+
+
+// the precisions used by the solvers: double, float, float storage with double recurrence
+template class BasicTridiagonal<double, double>;
+template class BasicTridiagonal<float, float>;
+template class BasicTridiagonal<float, double>;
@@ -0,0 +1,62 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+#ifndef TRIDIAGONAL_H
+#define TRIDIAGONAL_H
+#include "vector.h"
+
+
+// Tridiagonal system factorised once (Thomas algorithm forward elimination of the matrix only).
+// The implicit schemes have a matrix constant in time: it is factorised before the time loop,
+// then each time step only costs a forward and a back substitution on the right hand side, without any allocation.
+// Storage is the type of the factors and of the right hand sides (float halves the memory traffic), Compute the type of the recurrence:
+// with float storage and double Compute, the value carried from one row to the next never loses its double precision (mixed precision).
+template<class Storage, class Compute = Storage>
+class BasicTridiagonal {
+	// Attributes
+	private:
+		AlignedVector<Storage> lower; // lower diagonal a_i (a_0 is not used)
+		AlignedVector<Storage> upper; // modified upper diagonal c'_i = c_i / (b_i - a_i * c'_{i-1})
+		AlignedVector<Storage> pivot; // reciprocal pivots 1 / (b_i - a_i * c'_{i-1})
+
+	public:
+		// Default contructor: empty system, factorise has to be called before solve
+		BasicTridiagonal();
+
+		// Get method: number of rows of the system
+		int getSize() const;
+
+		// Methods
+		// factorise the matrix of diagonals a (coef for T_{i-1}), b (coef for T_{i}), c (coef for T_{i+1}), in double precision whatever the storage
+		void factorise(const Vector& a, const Vector& b, const Vector& c);
+
+		// solve the system for the right hand side d, the solution is written in d (a Vector for the double systems)
+		void solve(AlignedVector<Storage>& d) const;
+
+		// same as above for the getSize() values starting at d (a block of a larger vector)
+		void solve(Storage* d) const;
+
+		// one Crank-Nicolson step in a single pass: the right hand side d_i = side * level[i] + centre * level[i + 1] + side * level[i + 2]
+		// (+ firstWall on the first row and lastWall on the last one) is assembled during the forward substitution, in Compute precision,
+		// and the back substitution writes the solution straight into level[1 .. getSize()]. level[0] and level[getSize() + 1] are kept
+		void solveStencil(Compute side, Compute centre, Compute firstWall, Compute lastWall, Storage* level) const;
+};
+
+// the double precision system used by the solvers
+typedef BasicTridiagonal<double> Tridiagonal;
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+
+
+#ifndef CHECK_H
+#define CHECK_H
+#include "vector.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+
+// Checks of the test executables: each failed check is printed and counted, and main returns the count (0: passed)
+static int failures = 0;
+
+// largest absolute difference between two solutions, infinite if their sizes differ
+inline double maxDifference(const Vector& a, const Vector& b) {
+	if (a.getSize() != b.getSize())
+		return std::numeric_limits<double>::infinity();
+	double difference = 0;
+	for (int i = 0; i < a.getSize(); i++) {
+		double d = std::fabs(a[i] - b[i]);
+		if (!(d <= difference)) // a NaN on either side counts as a difference
+			difference = d;
+	}
+	return difference;
+}
+
+// largest absolute value of a solution
+inline double maxMagnitude(const Vector& a) {
+	double magnitude = 0;
+	for (int i = 0; i < a.getSize(); i++) {
+		magnitude = std::fmax(magnitude, std::fabs(a[i]));
+	}
+	return magnitude;
+}
+
+// check that the solutions a and b agree within tolerance (0: bit-identical)
+inline void expectClose(const std::string& what, const Vector& a, const Vector& b, double tolerance) {
+	double difference = maxDifference(a, b);
+	if (!(difference <= tolerance)) {
+		std::cout << "FAILED " << what << ": largest difference " << difference << " (tolerance " << tolerance << ")" << std::endl;
+		failures++;
+	}
+}
+
+// check a condition
+inline void expect(const std::string& what, bool condition) {
+	if (!condition) {
+		std::cout << "FAILED " << what << std::endl;
+		failures++;
+	}
+}
+
+// Problem of the solver checks: a wall of unit thickness and diffusivity, both sides at 149 K and 38 K inside
+static const double wallThickness = 1, wallDiffusivity = 1, wallTsurf = 149, wallTinit = 38;
+
+// set the problem on an Explicit or Implicit solver: spaceDomain space steps, timeDomain time levels and a time step of dtFactor dx^2
+// (a = 2 D dt / dx^2 = 2 dtFactor), in symmetric mode or not
+template<class Solver>
+void setProblem(Solver& solver, int spaceDomain, int timeDomain, double dtFactor, bool symmetric = false) {
+	double dx = wallThickness / spaceDomain;
+	solver.setDeltat(dtFactor * dx * dx / wallDiffusivity);
+	solver.setDeltax(dx);
+	solver.setD_value(wallDiffusivity);
+	solver.setSpaceDomain(spaceDomain);
+	solver.setTimeDomain(timeDomain);
+	solver.setT_surf(wallTsurf);
+	solver.setT_init(wallTinit);
+	solver.setSymmetric(symmetric);
+}
+#endif
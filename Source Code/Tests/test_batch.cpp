@@ -0,0 +1,66 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+
+
+// The batch solvers (Implicit::laasonenSolveBatch, Implicit::crankNicolsonSolveBatch) against the same walls solved one by one
+
+
+#include "check.h"
+#include "implicit.h"
+#include <sstream>
+
+
+// wall k of the batch: its own diffusivity and temperatures
+static void setWall(Implicit& solver, int spaceDomain, double D, double Tsurf, double Tinit) {
+	solver.setDeltat(0.01);
+	solver.setDeltax(31.0 / spaceDomain);
+	solver.setD_value(D);
+	solver.setSpaceDomain(spaceDomain);
+	solver.setTimeDomain(51);
+	solver.setT_surf(Tsurf);
+	solver.setT_init(Tinit);
+}
+
+int main() {
+	const int K = 5; // not a multiple of the vector lanes
+	int grids[] = { 3, 4, 21, 200 };
+	for (int g = 0; g < 4; g++) {
+		int spaceDomain = grids[g];
+		Vector Diffs(K), Tsurfs(K), Tinits(K);
+		for (int k = 0; k < K; k++) {
+			Diffs[k] = 93 * (1 + 0.5 * k);
+			Tsurfs[k] = 149 + 10 * k;
+			Tinits[k] = 38 - 5 * k;
+		}
+		Implicit batch;
+		setWall(batch, spaceDomain, 93, 149, 38);
+		std::vector<Vector> laasonen = batch.laasonenSolveBatch(Diffs, Tsurfs, Tinits);
+		std::vector<Vector> crankNicolson = batch.crankNicolsonSolveBatch(Diffs, Tsurfs, Tinits);
+		expect("batch size", laasonen.size() == K && crankNicolson.size() == K);
+		for (int k = 0; k < K && k < int(laasonen.size()) && k < int(crankNicolson.size()); k++) {
+			Implicit single;
+			setWall(single, spaceDomain, Diffs[k], Tsurfs[k], Tinits[k]);
+			std::ostringstream wall;
+			wall << " of the wall " << k << ", spaceDomain " << spaceDomain;
+			expectClose("laasonenSolveBatch" + wall.str(), laasonen[k], single.laasonenSolve(), 1e-9);
+			expectClose("crankNicolsonSolveBatch" + wall.str(), crankNicolson[k], single.crankNicolsonSolve(), 1e-9);
+		}
+	}
+	return failures;
+}
@@ -0,0 +1,60 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+
+
+// The threaded time march of the explicit schemes (Explicit::setThreads, advanceParallel: subdomains with halos exchanged at every step)
+// against the serial level by level march, for 2 to 4 threads on the smallest grids that are split and on a larger one
+
+
+#include "check.h"
+#include "explicit.h"
+#include <sstream>
+
+
+int main() {
+	for (int count = 2; count <= 4; count++) {
+		int grids[] = { 2048 * count + 1, 10007 }; // the grid is split from 2048 interior nodes per thread
+		for (int g = 0; g < 2; g++) {
+			Explicit parallel, serial;
+			setProblem(parallel, grids[g], 40, 0.05); // a = 0.1: Richardson stays finite over the few steps
+			setProblem(serial, grids[g], 40, 0.05);
+			parallel.setTemporalBlocking(1, 8192);
+			serial.setTemporalBlocking(1, 8192); // level by level
+			parallel.setThreads(count);
+			std::ostringstream setup;
+			setup << ", " << count << " threads, spaceDomain " << grids[g];
+			for (int method = 1; method <= 4; method++) {
+				std::ostringstream start;
+				start << "duFortSolve(" << method << ")" << setup.str();
+				expectClose(start.str(), parallel.duFortSolve(method), serial.duFortSolve(method), 1e-9);
+			}
+			expectClose("richardsonSolve" + setup.str(), parallel.richardsonSolve(), serial.richardsonSolve(), 1e-9);
+
+			// steady state: every thread stops at the same step as the serial march
+			setProblem(parallel, grids[g], 2000, 0.45); // a = 0.9
+			setProblem(serial, grids[g], 2000, 0.45);
+			parallel.setSteadyTolerance(0.05);
+			serial.setSteadyTolerance(0.05);
+			expectClose("steady duFortSolve(1)" + setup.str(), parallel.duFortSolve(1), serial.duFortSolve(1), 1e-9);
+			expect("steady state reached" + setup.str(), serial.getStoppedStep() > 0);
+			expect("same steady step" + setup.str(), parallel.getStoppedStep() == serial.getStoppedStep());
+		}
+	}
+	return failures;
+}
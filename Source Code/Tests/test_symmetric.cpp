@@ -0,0 +1,73 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+
+
+// Symmetric mode (setSymmetric): the half wall marched up to the centreline with a mirror condition there, then unfolded (unfoldHalf),
+// against the whole wall. Even numbers of space steps (centreline on a node, MirrorOnNode) and odd ones (between two nodes,
+// MirrorBetweenNodes), every explicit start method and scheme, both implicit schemes and the exact solution.
+// Below 4 space steps the solvers keep the whole wall: the results are then bit-identical
+
+
+#include "check.h"
+#include "explicit.h"
+#include "implicit.h"
+#include "exact.h"
+#include <sstream>
+
+
+int main() {
+	int grids[] = { 2, 3, 4, 5, 20, 21, 200, 201 };
+	for (int g = 0; g < 8; g++) {
+		int N = grids[g];
+		double tolerance = (N < 4) ? 0 : 1e-9; // the half march rounds differently from the whole one
+		std::ostringstream setup;
+		setup << ", spaceDomain " << N;
+
+		for (int precision = 1; precision <= 3; precision += 2) { // double and mixed
+			Explicit half, whole;
+			setProblem(half, N, 30, 0.2, true); // a = 0.4: Richardson stays finite over the few steps
+			setProblem(whole, N, 30, 0.2);
+			half.setPrecision(precision);
+			whole.setPrecision(precision);
+			double limit = (precision == 1) ? tolerance : (N < 4) ? 0 : 1e-4;
+			std::ostringstream mode;
+			mode << setup.str() << ", precision " << precision;
+			for (int method = 1; method <= 4; method++) {
+				std::ostringstream start;
+				start << "duFortSolve(" << method << ")" << mode.str();
+				expectClose(start.str(), half.duFortSolve(method), whole.duFortSolve(method), limit);
+			}
+			Vector richardson = whole.richardsonSolve(); // unstable: the rounding grows with the solution, the tolerance is relative
+			expectClose("richardsonSolve" + mode.str(), half.richardsonSolve(), richardson, limit * std::fmax(1, maxMagnitude(richardson) / wallTsurf));
+		}
+
+		Implicit half, whole;
+		setProblem(half, N, 30, 0.2, true);
+		setProblem(whole, N, 30, 0.2);
+		expectClose("laasonenSolve" + setup.str(), half.laasonenSolve(), whole.laasonenSolve(), tolerance);
+		expectClose("crankNicolsonSolve" + setup.str(), half.crankNicolsonSolve(), whole.crankNicolsonSolve(), tolerance);
+
+		ExactSolution exactHalf(wallDiffusivity, wallThickness, wallTsurf, wallTinit), exactWhole(wallDiffusivity, wallThickness, wallTsurf, wallTinit);
+		exactHalf.setSymmetric(true);
+		exactHalf.setTime(0.01);
+		exactWhole.setTime(0.01);
+		expectClose("ExactSolution::evaluate" + setup.str(), exactHalf.evaluate(N + 1, wallThickness / N), exactWhole.evaluate(N + 1, wallThickness / N), 1e-9);
+	}
+	return failures;
+}
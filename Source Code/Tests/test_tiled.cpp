@@ -0,0 +1,55 @@
+/***********************************************************************\
+#                                                                       #
+#                C R A N F I E L D   U N I V E R S I T Y                #
+#                          2 0 1 9  /  2 0 2 0                          #
+#                                                                       #
+#               MSc in Aerospace Computational Engineering              #
+#                                                                       #
+#                   1D HEAT CONDUCTION EQUATION SOLVER                  #
+#                                                                       #
+#-----------------------------------------------------------------------#
+#                                                                       #
+#   Main Contributors:                                                  #
+#       Sevan Retif            (Email: Sevan.Retif@cranfield.ac.uk)     #
+#       Elias Farah            (Email: E.Farah@cranfield.ac.uk)         #
+#                                                                       #
+\***********************************************************************/
+
+
+
+
+// The tiled time march of the explicit schemes (temporal blocking, Explicit::advanceTiled) is bit-identical to the level by level march,
+// for grids just below, at and above the 2 tiles from which it is used, and for a number of steps that is not a multiple of the tile steps
+
+
+#include "check.h"
+#include "explicit.h"
+#include <sstream>
+
+
+int main() {
+	int tiles[][2] = { { 2, 16 }, { 7, 50 }, { 32, 64 } }; // tile steps, tile nodes
+	for (int k = 0; k < 3; k++) {
+		int steps = tiles[k][0], nodes = tiles[k][1];
+		int grids[] = { 2 * nodes - 1, 2 * nodes, 2 * nodes + 1, 5 * nodes + 3 }; // nodes of the grid (spaceDomain + 1)
+		int times[] = { 3, steps + 2, 3 * steps + 5 };
+		for (int g = 0; g < 4; g++) {
+			for (int t = 0; t < 3; t++) {
+				Explicit tiled, sweep;
+				setProblem(tiled, grids[g] - 1, times[t], 0.05); // a = 0.1: Richardson stays finite over the few steps
+				setProblem(sweep, grids[g] - 1, times[t], 0.05);
+				tiled.setTemporalBlocking(steps, nodes);
+				sweep.setTemporalBlocking(1, nodes);
+				std::ostringstream setup;
+				setup << ", tiles of " << steps << " steps and " << nodes << " nodes, " << grids[g] << " nodes, timeDomain " << times[t];
+				for (int method = 1; method <= 4; method++) {
+					std::ostringstream start;
+					start << "duFortSolve(" << method << ")" << setup.str();
+					expectClose(start.str(), tiled.duFortSolve(method), sweep.duFortSolve(method), 0);
+				}
+				expectClose("richardsonSolve" + setup.str(), tiled.richardsonSolve(), sweep.richardsonSolve(), 0);
+			}
+		}
+	}
+	return failures;
+}